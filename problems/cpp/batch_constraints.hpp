@@ -0,0 +1,125 @@
+#ifndef BATCH_CONSTRAINTS_HPP
+#define BATCH_CONSTRAINTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "constraints.hpp"
+#include "point_batch.hpp"
+#include "simd_math.hpp"
+
+/*-----------------------------------------------------------------*/
+/*        Vectorized stencils of the six families of constraints   */
+/*-----------------------------------------------------------------*/
+//
+// Constraint j of families 1 to 5 only reads x_j, x_j+1 (and x_j+2), and
+// family 6 is the sum of the constraints of family 5. The kernels
+// (constraint_kernels.inc) evaluate these stencils with the packs of
+// simd_math.hpp, compiled for each instruction set and dispatched like the
+// batched objectives:
+//  - point: the nb_constraints(family, n) values of one point written to
+//    c in one pass, P::width constraints at a time;
+//  - batch: nb points stored coordinate-major (coordinate i of point k is
+//    x[i * ld + k]), constraint j of point k written to c[j * ldc + k].
+//    Each coordinate is loaded once per P::width points;
+//  - violations: same pass as batch, without storing the constraints,
+//    h = sum_j max(0, c_j)^2 and the number of violated constraints.
+// Family 6 sums its terms in the same pass instead of storing them.
+//
+// The expressions are those of eval_constraints; the values can only
+// differ from it by the contraction of products and sums into FMAs by the
+// compiler and, for family 6, by the order of the sum (lanes summed last).
+
+namespace bbproblems
+{
+
+struct ConstraintKernels
+{
+    void (*point)(int n, const double *x, double *c);
+    void (*batch)(int n, int nb, const double *x, size_t ld, double *c, size_t ldc);
+    void (*violations)(int n, int nb, const double *x, size_t ld, double *h, int *nviol);
+};
+
+#ifdef BBPROBLEMS_X86
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+namespace simd
+{
+namespace sse42
+{
+#include "constraint_kernels.inc"
+} // namespace sse42
+} // namespace simd
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace simd
+{
+namespace avx2
+{
+#include "constraint_kernels.inc"
+} // namespace avx2
+} // namespace simd
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace simd
+{
+namespace avx512
+{
+#include "constraint_kernels.inc"
+} // namespace avx512
+} // namespace simd
+#pragma GCC pop_options
+#endif
+
+namespace simd
+{
+namespace scalar
+{
+#include "constraint_kernels.inc"
+} // namespace scalar
+} // namespace simd
+
+// kernels of family (1 .. 6) for isa
+inline ConstraintKernels constraint_kernels(int family, simd::Isa isa = simd::active_isa())
+{
+    switch (isa)
+    {
+#ifdef BBPROBLEMS_X86
+    case simd::ISA_AVX512:
+        return simd::avx512::constraint_kernels(family);
+    case simd::ISA_AVX2:
+        return simd::avx2::constraint_kernels(family);
+    case simd::ISA_SSE42:
+        return simd::sse42::constraint_kernels(family);
+#endif
+    default:
+        return simd::scalar::constraint_kernels(family);
+    }
+}
+
+// constraints of the points of x (PointBatch of point_batch.hpp), with the
+// kernels of the active instruction set; c is reshaped to the
+// nb_constraints(family, x.n()) constraints of the points
+inline void eval_constraints_batch(int family, const PointBatch &x, PointBatch &c)
+{
+    c.conform(nb_constraints(family, x.n()), x);
+    constraint_kernels(family).batch(x.n(), x.padded_size(), x.data(), x.ld(), c.data(), c.ld());
+}
+
+// violation h and number of violated constraints of the points of x
+inline void eval_violations_batch(int family, const PointBatch &x, std::vector<double> &h, std::vector<int> &nviol)
+{
+    h.resize(x.padded_size());
+    nviol.resize(x.padded_size());
+    constraint_kernels(family).violations(x.n(), x.padded_size(), x.data(), x.ld(), h.data(), nviol.data());
+    h.resize(x.size());
+    nviol.resize(x.size());
+}
+
+} // namespace bbproblems
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef BATCH_PROBLEMS_HPP
+#define BATCH_PROBLEMS_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "point_batch.hpp"
+#include "problem_dsl.hpp"
+#include "problems.hpp"
+#include "simd_math.hpp"
+
+/*-----------------------------------------------------------------*/
+/*            Batched objectives of the problems                   */
+/*-----------------------------------------------------------------*/
+//
+// Points and objectives are PointBatch (point_batch.hpp): coordinate i of
+// point k is x[i * ld + k], and objective j of point k is written to
+// f[j * ld + k], with the same ld.
+// The kernels of the problems of the drivers are generated from their
+// declarations (dsl_problems.inc, see problem_dsl.hpp): they evaluate
+// P::width points at once with the same expressions as all_problems, the
+// calls to sin, cos, exp and pow being those of simd_math.hpp. Like the math
+// functions, they are compiled for each instruction set, and
+// batch_objectives returns those of the active one. With the vector packs,
+// objectives may differ from the scalar functions by the errors of
+// simd_math.hpp propagated through the expressions (relative differences
+// below 1e-13 on the bounds, checked by simd_math_check); with the scalar
+// ones they are the same.
+//
+// The DTLZ problems of any size and number of objectives have kernels
+// (dtlz_kernels.inc) taking n, each objective being written to f[j * ld]
+// as the others. WFG1-9 have kernels (wfg_kernels.inc) chaining their
+// transformations as stages over the pack. Problems without a kernel here
+// are evaluated point by point by eval_objectives_batch.
+
+namespace bbproblems
+{
+
+// objectives of nb points of n variables, stored as for BatchObjectiveFunction
+typedef void (*ScalableBatchObjectiveFunction)(int n, int nb, const double *x, size_t ld, double *f);
+
+#ifdef BBPROBLEMS_X86
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+namespace simd
+{
+namespace sse42
+{
+#include "problem_dsl.inc"
+#include "dsl_problems.inc"
+#include "batch_kernels.inc"
+#include "dtlz_kernels.inc"
+#include "wfg_kernels.inc"
+} // namespace sse42
+} // namespace simd
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace simd
+{
+namespace avx2
+{
+#include "problem_dsl.inc"
+#include "dsl_problems.inc"
+#include "batch_kernels.inc"
+#include "dtlz_kernels.inc"
+#include "wfg_kernels.inc"
+} // namespace avx2
+} // namespace simd
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace simd
+{
+namespace avx512
+{
+#include "problem_dsl.inc"
+#include "dsl_problems.inc"
+#include "batch_kernels.inc"
+#include "dtlz_kernels.inc"
+#include "wfg_kernels.inc"
+} // namespace avx512
+} // namespace simd
+#pragma GCC pop_options
+#endif
+
+namespace simd
+{
+namespace scalar
+{
+// problem_dsl.inc and dsl_problems.inc: in problem_dsl.hpp
+#include "batch_kernels.inc"
+#include "dtlz_kernels.inc"
+#include "wfg_kernels.inc"
+} // namespace scalar
+} // namespace simd
+
+// kernel of the problem for isa, nullptr if it has none
+inline BatchObjectiveFunction batch_objectives(const std::string &name, simd::Isa isa = simd::active_isa())
+{
+    switch (isa)
+    {
+#ifdef BBPROBLEMS_X86
+    case simd::ISA_AVX512:
+        return simd::avx512::batch_objectives(name);
+    case simd::ISA_AVX2:
+        return simd::avx2::batch_objectives(name);
+    case simd::ISA_SSE42:
+        return simd::sse42::batch_objectives(name);
+#endif
+    default:
+        return simd::scalar::batch_objectives(name);
+    }
+}
+
+// kernel of a family of constraints (1 .. 6) generated from its declaration
+// for isa (dsl_check compares them with those of batch_constraints.hpp)
+inline DslConstraintFunction dsl_family_constraints(int family, simd::Isa isa = simd::active_isa())
+{
+    switch (isa)
+    {
+#ifdef BBPROBLEMS_X86
+    case simd::ISA_AVX512:
+        return simd::avx512::dsl::family_constraints(family);
+    case simd::ISA_AVX2:
+        return simd::avx2::dsl::family_constraints(family);
+    case simd::ISA_SSE42:
+        return simd::sse42::dsl::family_constraints(family);
+#endif
+    default:
+        return simd::scalar::dsl::family_constraints(family);
+    }
+}
+
+// kernel of DTLZ<variant> for m objectives for isa
+inline ScalableBatchObjectiveFunction dtlz_batch_objectives(int variant, int m, simd::Isa isa = simd::active_isa())
+{
+    switch (isa)
+    {
+#ifdef BBPROBLEMS_X86
+    case simd::ISA_AVX512:
+        return simd::avx512::dtlz_batch_objectives(variant, m);
+    case simd::ISA_AVX2:
+        return simd::avx2::dtlz_batch_objectives(variant, m);
+    case simd::ISA_SSE42:
+        return simd::sse42::dtlz_batch_objectives(variant, m);
+#endif
+    default:
+        return simd::scalar::dtlz_batch_objectives(variant, m);
+    }
+}
+
+// objectives of the points of x (pb.n coordinates), with the kernels of the
+// active instruction set; f is reshaped to pb.m objectives like x
+inline void eval_objectives_batch(const Problem &pb, const PointBatch &x, PointBatch &f)
+{
+    f.conform(pb.m, x);
+    size_t ld = x.ld();
+    BatchObjectiveFunction kernel = batch_objectives(pb.name);
+    if (kernel != nullptr)
+    {
+        kernel(x.padded_size(), x.data(), ld, f.data());
+        return;
+    }
+    int variant, m, n;
+    if (parse_dtlz_name(pb.name, variant, m, n))
+    {
+        dtlz_batch_objectives(variant, m)(n, x.padded_size(), x.data(), ld, f.data());
+        return;
+    }
+    std::vector<double> xk(pb.n), fk(pb.m);
+    for (int k = 0; k < x.size(); ++k)
+    {
+        for (int i = 0; i < pb.n; ++i)
+        {
+            xk[i] = x(i, k);
+        }
+        pb.objectives(xk.data(), fk.data());
+        for (int j = 0; j < pb.m; ++j)
+        {
+            f(j, k) = fk[j];
+        }
+    }
+}
+
+} // namespace bbproblems
+
+#endif
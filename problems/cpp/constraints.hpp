@@ -0,0 +1,92 @@
+#ifndef CONSTRAINTS_HPP
+#define CONSTRAINTS_HPP
+
+#include <cstddef>
+#include <vector>
+
+/*-----------------------------------------------------------------*/
+/*  The six families of constraints (folders fconstriq1 .. 6)      */
+/*-----------------------------------------------------------------*/
+//
+// Same expressions as the BiMADS drivers and as constraints1 ..
+// constraints6 in scripts/analytical/generate_analytical_dmultimads.jl.
+// A point is feasible iff all constraints are <= 0. Its violation is
+// h = sum_j max(0, c_j)^2, as in the progressive barrier.
+
+namespace bbproblems
+{
+
+const int NB_FAMILIES = 6;
+
+// number of constraints of family (1 .. 6) for a problem with n variables
+inline int nb_constraints(int family, int n)
+{
+    switch (family)
+    {
+    case 1:
+    case 2:
+    case 5:
+        return n - 2;
+    case 3:
+    case 4:
+        return n - 1;
+    default:
+        return 1;
+    }
+}
+
+// write the nb_constraints(family, n) values in c
+inline void eval_constraints(int family, int n, const double *x, double *c)
+{
+    switch (family)
+    {
+    case 1:
+        for (int j = 0; j < n - 2; ++j)
+            c[j] = (3 - 2 * x[j + 1]) * x[j + 1] - x[j] - 2 * x[j + 2] + 1;
+        break;
+    case 2:
+        for (int j = 0; j < n - 2; ++j)
+            c[j] = (3 - 2 * x[j + 1]) * x[j + 1] - x[j] - 2 * x[j + 2] + 2.5;
+        break;
+    case 3:
+        for (int j = 0; j < n - 1; ++j)
+            c[j] = x[j] * x[j] + x[j + 1] * x[j + 1] + x[j] * x[j + 1] - 2 * x[j] - 2 * x[j + 1] + 1;
+        break;
+    case 4:
+        for (int j = 0; j < n - 1; ++j)
+            c[j] = x[j] * x[j] + x[j + 1] * x[j + 1] + x[j] * x[j + 1] - 1;
+        break;
+    case 5:
+        for (int j = 0; j < n - 2; ++j)
+            c[j] = (3 - 0.5 * x[j + 1]) * x[j + 1] - x[j] - 2 * x[j + 2] + 1;
+        break;
+    default:
+    {
+        double s = 0;
+        for (int i = 0; i < n - 2; ++i)
+            s += ((3 - 0.5 * x[i + 1]) * x[i + 1] - x[i] - 2 * x[i + 2] + 1);
+        c[0] = s;
+    }
+    }
+}
+
+// violation h and number of violated constraints of one point
+inline void eval_violation(int family, int n, const double *x, double &h, int &nviol)
+{
+    std::vector<double> c(nb_constraints(family, n));
+    eval_constraints(family, n, x, c.data());
+    h = 0;
+    nviol = 0;
+    for (double cj : c)
+    {
+        if (!(cj <= 0))
+        {
+            h += cj * cj;
+            ++nviol;
+        }
+    }
+}
+
+} // namespace bbproblems
+
+#endif
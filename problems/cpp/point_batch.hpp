@@ -0,0 +1,287 @@
+#ifndef POINT_BATCH_HPP
+#define POINT_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*-----------------------------------------------------------------*/
+/*        Coordinate-major batches of points for the kernels       */
+/*-----------------------------------------------------------------*/
+//
+// Coordinate i of point k is at data()[i * ld() + k]: the layout read and
+// written by the kernels of batch_problems.hpp and batch_constraints.hpp,
+// which load P::width consecutive points of one coordinate at once.
+//
+// An owning batch rounds ld() up to PAD = 8 doubles (the width of AVX-512)
+// and aligns its storage on 64 bytes, so that each coordinate starts on a
+// cache line and the kernels can evaluate whole packs up to padded_size()
+// without the copy of the last partial pack. The padding lanes hold finite
+// values (zeros, or points of a previous batch); the values computed on
+// them are not part of the batch.
+//
+// Points enter and leave the batch without intermediate copies:
+//  - gather/scatter of a point-major array, point k at points[k * ldp] (a
+//    Julia Matrix{Float64} of size n x nb, such as the candidates of
+//    search_and_poll!, is point-major with ldp = n);
+//  - gather/scatter of a list of points (e.g. the NOMAD::Eval_Point of a
+//    block), through an accessor of their coordinates;
+//  - view wraps memory that is already coordinate-major (a Julia nb x n
+//    matrix, ld = nb) without copying it nor owning it.
+
+namespace bbproblems
+{
+
+class PointBatch
+{
+    int dim = 0;          // coordinates per point
+    int count = 0;        // points in the batch
+    int reserved = 0;     // points that fit in the storage
+    size_t stride = 0;    // leading dimension
+    size_t allocated = 0; // doubles of the owned storage
+    double *values = nullptr;
+    bool owner = false;
+
+    void release()
+    {
+        if (owner)
+            std::free(values);
+        values = nullptr;
+        owner = false;
+        allocated = 0;
+    }
+
+    // owned storage of n coordinates of leading dimension ld, kept if it fits
+    void allocate(int n, size_t ld)
+    {
+        size_t size = static_cast<size_t>(n) * ld;
+        if (!owner || size > allocated)
+        {
+            release();
+            size_t bytes = (std::max<size_t>(1, size) * sizeof(double) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            values = static_cast<double *>(std::aligned_alloc(ALIGNMENT, bytes));
+            if (values == nullptr)
+                throw std::bad_alloc();
+            std::memset(values, 0, bytes);
+            owner = true;
+            allocated = bytes / sizeof(double);
+        }
+        dim = n;
+        stride = ld;
+        reserved = static_cast<int>(ld);
+        count = 0;
+    }
+
+public:
+    static const int PAD = 8;
+    static const size_t ALIGNMENT = 64;
+
+    PointBatch() = default;
+
+    // empty batch of points of dimension n, storage for capacity points
+    PointBatch(int n, int capacity)
+    {
+        reshape(n, capacity);
+    }
+
+    // batch on coordinate-major memory owned by the caller (zero-copy)
+    static PointBatch view(int n, int nb, double *x, size_t ld)
+    {
+        if (n < 0 || nb < 0 || ld < static_cast<size_t>(nb))
+            throw std::invalid_argument("PointBatch::view: ld smaller than the number of points");
+        PointBatch b;
+        b.dim = n;
+        b.count = b.reserved = nb;
+        b.stride = ld;
+        b.values = x;
+        return b;
+    }
+
+    ~PointBatch()
+    {
+        release();
+    }
+
+    PointBatch(const PointBatch &) = delete;
+    PointBatch &operator=(const PointBatch &) = delete;
+
+    PointBatch(PointBatch &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    PointBatch &operator=(PointBatch &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            dim = other.dim;
+            count = other.count;
+            reserved = other.reserved;
+            stride = other.stride;
+            allocated = other.allocated;
+            values = other.values;
+            owner = other.owner;
+            other.values = nullptr;
+            other.owner = false;
+            other.count = other.reserved = 0;
+            other.stride = other.allocated = 0;
+        }
+        return *this;
+    }
+
+    // empty owning batch of points of dimension n, storage for capacity
+    // points (reallocated only if it does not fit in the current storage)
+    void reshape(int n, int capacity)
+    {
+        if (n < 0 || capacity < 0)
+            throw std::invalid_argument("PointBatch: negative size");
+        allocate(n, (static_cast<size_t>(capacity) + PAD - 1) / PAD * PAD);
+    }
+
+    // same shape as other (size and leading dimension), with n coordinates:
+    // the output batch of a kernel reading other
+    void conform(int n, const PointBatch &other)
+    {
+        allocate(n, other.stride);
+        count = other.count;
+    }
+
+    // number of points, at most capacity() (the storage is kept)
+    void resize(int nb)
+    {
+        if (nb < 0 || nb > reserved)
+            throw std::length_error("PointBatch: more points than the capacity");
+        count = nb;
+    }
+
+    int n() const
+    {
+        return dim;
+    }
+
+    int size() const
+    {
+        return count;
+    }
+
+    int capacity() const
+    {
+        return reserved;
+    }
+
+    size_t ld() const
+    {
+        return stride;
+    }
+
+    // points the kernels may evaluate: size() rounded up to PAD for an
+    // owning batch, size() for a view
+    int padded_size() const
+    {
+        if (!owner)
+            return count;
+        return std::min(reserved, (count + PAD - 1) / PAD * PAD);
+    }
+
+    double *data()
+    {
+        return values;
+    }
+
+    const double *data() const
+    {
+        return values;
+    }
+
+    // coordinate i of all the points
+    double *coordinate(int i)
+    {
+        return values + i * stride;
+    }
+
+    const double *coordinate(int i) const
+    {
+        return values + i * stride;
+    }
+
+    double &operator()(int i, int k)
+    {
+        return values[i * stride + k];
+    }
+
+    double operator()(int i, int k) const
+    {
+        return values[i * stride + k];
+    }
+
+    // nb points of a point-major array, point k at points[k * ldp]
+    void gather(int nb, const double *points, size_t ldp)
+    {
+        if (nb > reserved && (owner || values == nullptr))
+            reshape(dim, nb);
+        resize(nb);
+        for (int k = 0; k < nb; ++k)
+        {
+            const double *p = points + k * ldp;
+            for (int i = 0; i < dim; ++i)
+            {
+                values[i * stride + k] = p[i];
+            }
+        }
+    }
+
+    void scatter(double *points, size_t ldp) const
+    {
+        for (int k = 0; k < count; ++k)
+        {
+            double *p = points + k * ldp;
+            for (int i = 0; i < dim; ++i)
+            {
+                p[i] = values[i * stride + k];
+            }
+        }
+    }
+
+    // points of [first, last), coordinate i of point *it given by get(*it, i)
+    template <class Iterator, class Getter>
+    void gather(Iterator first, Iterator last, Getter get)
+    {
+        int nb = static_cast<int>(std::distance(first, last));
+        if (nb > reserved && (owner || values == nullptr))
+            reshape(dim, nb);
+        resize(nb);
+        int k = 0;
+        for (Iterator it = first; it != last; ++it, ++k)
+        {
+            for (int i = 0; i < dim; ++i)
+            {
+                values[i * stride + k] = get(*it, i);
+            }
+        }
+    }
+
+    // set(*it, i, value) for each coordinate i of each point, in the order
+    // of [first, last) (size() points)
+    template <class Iterator, class Setter>
+    void scatter(Iterator first, Iterator last, Setter set) const
+    {
+        int k = 0;
+        for (Iterator it = first; it != last && k < count; ++it, ++k)
+        {
+            for (int i = 0; i < dim; ++i)
+            {
+                set(*it, i, values[i * stride + k]);
+            }
+        }
+    }
+};
+
+} // namespace bbproblems
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef PROBLEM_DSL_HPP
+#define PROBLEM_DSL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "rotation_cache.hpp"
+#include "simd_math.hpp"
+
+/*-----------------------------------------------------------------*/
+/*      Problems declared once, evaluators generated per pack      */
+/*-----------------------------------------------------------------*/
+//
+// A problem is written once as an expression (problem_dsl.inc), e.g.
+//
+//   inline constexpr auto ZDT1 = model<30>(
+//       lets(let(g, sum(I, 1, 30, x(I)) * (9.0 / 29) + 1), let(h, x[0])),
+//       objectives(h, g * (1 - sqrt(h / g))));
+//
+// and declared with its name and bounds (declare<ZDT1>("ZDT1", 0, 1)).
+// The expression is a tree of types: the compiler generates from it the
+// kernel of each instruction set of simd_math.hpp (P::width points per
+// pass, sin, cos, exp, log and pow of simd_math.hpp), the scalar evaluator
+// being the kernel of simd::scalar on one point. The number of objectives,
+// of constraints and the temporaries are deduced from the expression.
+//
+// The declarations of dsl_problems.inc are the only definition of the
+// problems of the drivers: all_problems (problems.hpp) is built from their
+// scalar kernels, declared here, and batch_objectives (batch_problems.hpp)
+// returns their kernel for the active instruction set, compiled there.
+//
+//  - x[i], x(I + 1): coordinates; I, J the indices of sum, prod, each and
+//    let; N the number of variables (bounds of the loops N - 2...);
+//  - sum(I, from, to, body[, init]), prod(...): reductions in this order;
+//  - let(g, e), let(y(I), e): temporaries g, h, u and y(0 .. n - 1),
+//    computed once per pack before the objectives (g(x) of the ZDT-like
+//    problems, rotated points y = A x);
+//  - mat(rotation_A10, I, J): the matrices of rotation_cache.hpp, read
+//    through their accessors;
+//    tabulate<size>(I, e): terms that only depend on I, computed once;
+//  - constraints(each(I, 0, N - 2, e), e2...): constraints, as stencils;
+//    the six families of constraints.hpp are such blocks on any n.
+//
+// Parts of the expressions that do not depend on x are computed with libm
+// on doubles and broadcast. With the vector packs, values differ from the
+// scalar ones by the errors of simd_math.hpp (below 1e-13 relative on the
+// bounds, checked by dsl_check). pow(a, p) of a < 0 is only defined for
+// integer p, computed as |a|^p with its sign (the vector pow of
+// simd_math.hpp needs a >= 0).
+
+namespace bbproblems
+{
+
+constexpr double PI = 3.141592653589793238463;
+
+// objectives of nb points stored coordinate-major (batch_problems.hpp)
+typedef void (*BatchObjectiveFunction)(int nb, const double *x, size_t ld, double *f);
+
+// starting points of a problem from its bounds
+typedef std::vector<std::vector<double>> (*StartingPoints)(const std::vector<double> &lb,
+                                                           const std::vector<double> &ub);
+
+// the n starting points of the drivers: x0_j = lb + j (ub - lb) / (n - 1)
+inline std::vector<std::vector<double>> diagonal_starting_points(const std::vector<double> &lb,
+                                                                 const std::vector<double> &ub)
+{
+    int n = static_cast<int>(lb.size());
+    std::vector<std::vector<double>> x0s;
+    for (int j = 0; j < n; ++j)
+    {
+        std::vector<double> x0(n);
+        for (int i = 0; i < n; ++i)
+        {
+            x0[i] = lb[i] + j * (ub[i] - lb[i]) / (n - 1);
+        }
+        x0s.push_back(x0);
+    }
+    return x0s;
+}
+
+// constraints of a block on n variables, as ConstraintKernels::batch
+typedef void (*DslConstraintFunction)(int n, int nb, const double *x, size_t ld, double *c, size_t ldc);
+
+// a declared problem: metadata and its kernel for one instruction set
+struct DslDeclaration
+{
+    std::string name;
+    int n;  // variables
+    int m;  // objectives
+    int nc; // constraints of the problem itself
+    std::vector<double> lb, ub;
+    StartingPoints x0;
+    BatchObjectiveFunction objectives;
+    int version = 1; // to increase each time the declaration of the problem changes
+};
+
+// the scalar kernels, for all_problems; those of the vector instruction sets
+// are compiled by batch_problems.hpp
+namespace simd
+{
+namespace scalar
+{
+#include "problem_dsl.inc"
+#include "dsl_problems.inc"
+} // namespace scalar
+} // namespace simd
+
+// the declared problems, with their scalar kernels
+inline const std::vector<DslDeclaration> &dsl_declarations()
+{
+    return simd::scalar::dsl::declarations();
+}
+
+// the declared problems of problems/julia and problems/matlab that differ
+// from those of the drivers, with their scalar kernels
+inline const std::vector<DslDeclaration> &dsl_harness_declarations()
+{
+    return simd::scalar::dsl::harness_declarations();
+}
+
+} // namespace bbproblems
+
+#endif
@@ -0,0 +1,860 @@
+#ifndef PROBLEMS_HPP
+#define PROBLEMS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "constraints.hpp"
+#include "problem_dsl.hpp"
+#include "rotation_cache.hpp"
+#include "structured_rotation.hpp"
+
+/*-----------------------------------------------------------------*/
+/*  NOMAD-free versions of the problems of problems/bimads         */
+/*-----------------------------------------------------------------*/
+//
+// Each objective function reproduces the eval_x method of the
+// corresponding BiMADS driver operation by operation, so that tools
+// working outside of NOMAD (reference fronts, feasibility probes,
+// campaign runners...) see exactly the same values. The problems of the
+// drivers are declared once in dsl_problems.inc (problem_dsl.hpp), and
+// all_problems evaluates them with their scalar kernels.
+
+namespace bbproblems
+{
+
+// scalar kernels of the declarations, or closures holding the rotation of
+// the scalable variants
+typedef std::function<void(const double *x, double *f)> ObjectiveFunction;
+
+struct Problem
+{
+    std::string name;
+    int n;       // number of variables
+    int m;       // number of objectives
+    int version; // to increase each time the definition of the problem changes
+    std::vector<double> lb;
+    std::vector<double> ub;
+    ObjectiveFunction objectives;
+};
+
+/*----------------------------------------*/
+/*     g of the scalable variants         */
+/*----------------------------------------*/
+
+// g of L2ZDT1-3 and L3ZDT1-3
+inline double lzdt_g(const double *y, int n)
+{
+    double g = 1;
+    for (int i = 1; i < n; ++i)
+    {
+        g += (9.0 / (n - 1)) * y[i] * y[i];
+    }
+    return g;
+}
+
+// g of L2ZDT4 and L3ZDT4
+inline double lzdt4_g(const double *y, int n)
+{
+    double g = 1 + 10 * (n - 1);
+    for (int i = 1; i < n; ++i)
+    {
+        g += (y[i] * y[i] - 10 * cos(4 * PI * y[i]));
+    }
+    return g;
+}
+
+// g of L2ZDT6 and L3ZDT6
+inline double lzdt6_g(const double *y, int n)
+{
+    double tmp_g = 0;
+    for (int i = 1; i < n; ++i)
+    {
+        tmp_g += y[i] * y[i] / (n - 1);
+    }
+    return 1 + 9 * pow(tmp_g, 0.25);
+}
+
+/*----------------------------------------*/
+/*                registry                */
+/*----------------------------------------*/
+
+inline std::vector<double> bounds(int n, double v)
+{
+    return std::vector<double>(n, v);
+}
+
+// a declared problem, evaluated by its scalar kernel one point at a time
+inline Problem declared_problem(const DslDeclaration &d)
+{
+    BatchObjectiveFunction kernel = d.objectives;
+    return Problem{d.name, d.n, d.m, d.version, d.lb, d.ub,
+                   [kernel](const double *x, double *f) { kernel(1, x, 1, f); }};
+}
+
+// the problems of the drivers, with the names, bounds and versions of their
+// declarations (same bounds as the main functions of the BiMADS drivers)
+inline const std::vector<Problem> &all_problems()
+{
+    static const std::vector<Problem> problems = []()
+    {
+        std::vector<Problem> list;
+        for (const DslDeclaration &d : dsl_declarations())
+            list.push_back(declared_problem(d));
+        return list;
+    }();
+    return problems;
+}
+
+/*----------------------------------------*/
+/*           scalable variants            */
+/*----------------------------------------*/
+//
+// <base>-n<n>-s<seed> for base L1ZDT4, L2ZDT1-4, L2ZDT6, L3ZDT1-4 or
+// L3ZDT6: the objectives of base on n variables, with its dense matrix
+// replaced by the StructuredRotation of that size and seed (of size n - 1
+// for L1ZDT4, whose first variable is not rotated, as by MATRIX_D10). The
+// bounds are those of base extended to n. They are not in all_problems
+// (nor in the drivers); find_problem builds them from their name.
+
+inline bool is_scalable_base(const std::string &base)
+{
+    static const char *bases[] = {"L1ZDT4", "L2ZDT1", "L2ZDT2", "L2ZDT3", "L2ZDT4", "L2ZDT6",
+                                  "L3ZDT1", "L3ZDT2", "L3ZDT3", "L3ZDT4", "L3ZDT6"};
+    for (const char *b : bases)
+    {
+        if (base == b)
+            return true;
+    }
+    return false;
+}
+
+inline std::string scalable_name(const std::string &base, int n, uint64_t seed)
+{
+    return base + "-n" + std::to_string(n) + "-s" + std::to_string(seed);
+}
+
+// base must satisfy is_scalable_base, n >= 2
+inline Problem scalable_problem(const std::string &base, int n, uint64_t seed)
+{
+    bool l1 = (base == "L1ZDT4");
+    bool squared = (base[1] == '3');
+    char variant = base.back();
+    auto rot = std::make_shared<const StructuredRotation>(l1 ? n - 1 : n, seed);
+
+    Problem pb{scalable_name(base, n, seed), n, 2, 1, bounds(n, 0.0), bounds(n, 1.0), nullptr};
+    if (l1)
+    {
+        pb.lb = bounds(n, -5.0);
+        pb.ub = bounds(n, 5.0);
+        pb.lb[0] = 0.0;
+        pb.ub[0] = 1.0;
+    }
+
+    pb.objectives = [rot, n, l1, squared, variant](const double *x, double *f)
+    {
+        std::vector<double> xs(n), y(n);
+        if (l1)
+        {
+            y[0] = x[0];
+            rot->apply(x + 1, y.data() + 1);
+        }
+        else
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                xs[i] = squared ? x[i] * x[i] : x[i];
+            }
+            rot->apply(xs.data(), y.data());
+        }
+        f[0] = y[0] * y[0];
+
+        double g;
+        switch (variant)
+        {
+        case '4':
+            g = lzdt4_g(y.data(), n);
+            f[1] = g * (1 - sqrt(f[0] / g));
+            break;
+        case '6':
+            g = lzdt6_g(y.data(), n);
+            f[1] = g * (1 - (f[0] / g) * (f[0] / g));
+            break;
+        case '1':
+            g = lzdt_g(y.data(), n);
+            f[1] = g * (1 - sqrt(f[0] / g));
+            break;
+        case '2':
+            g = lzdt_g(y.data(), n);
+            f[1] = g * (1 - (f[0] / g) * (f[0] / g));
+            break;
+        default:
+            g = lzdt_g(y.data(), n);
+            f[1] = g * (1 - sqrt(f[0] / g) - (f[0] / g) * sin(10 * PI * f[0]));
+        }
+    };
+    return pb;
+}
+
+/*----------------------------------------*/
+/*        many-objective problems         */
+/*----------------------------------------*/
+//
+// DTLZ1-6 of problems/julia for m objectives on n >= m variables, with the
+// expressions of the Julia functions (k = n - m + 1). g(x_M) is computed
+// once per point, and the products of cosines (or of coordinates) shared
+// by the objectives are accumulated once, from f_m down to f_1.
+//
+// DTLZ<v> and DTLZ<v>n2 are the problems of problems/julia (m = 3, and
+// m = n = 2); DTLZ<v>-m<m> has m objectives and the k of DTLZ<v> (5 for
+// DTLZ1, 10 for DTLZ2-5, 20 for DTLZ6), DTLZ<v>-m<m>-n<n> n variables.
+// Bounds are [0, 1]. They are not in all_problems (nor in the drivers);
+// find_problem builds them from their name.
+
+const int DTLZ_MAX_OBJECTIVES = 10;
+
+template <int m>
+inline void DTLZ1(int n, const double *x, double *f)
+{
+    int k = n - m + 1;
+    double g = 0;
+    for (int i = m - 1; i < n; ++i)
+    {
+        g += (x[i] - 0.5) * (x[i] - 0.5) - cos(20 * PI * (x[i] - 0.5));
+    }
+    g = 100 * (k + g);
+
+    double h = 0.5 * (1 + g), prod = 1;
+    for (int i = m - 1; i > 0; --i)
+    {
+        f[i] = h * prod * (1 - x[m - 1 - i]);
+        prod *= x[m - 1 - i];
+    }
+    f[0] = h * prod;
+}
+
+// f_i = (1 + g) prod_{j < m - i} cos(pi / 2 y_j) sin(pi / 2 y_m-i), from g
+// and the coordinates y of DTLZ2, DTLZ3 and DTLZ4
+template <int m>
+inline void dtlz_sphere(double g, const double *y, double *f)
+{
+    double prod = 1;
+    for (int i = m - 1; i > 0; --i)
+    {
+        f[i] = (1 + g) * prod * sin(0.5 * PI * y[m - 1 - i]);
+        prod *= cos(0.5 * PI * y[m - 1 - i]);
+    }
+    f[0] = (1 + g) * prod;
+}
+
+template <int m>
+inline void DTLZ2(int n, const double *x, double *f)
+{
+    double g = 0;
+    for (int i = m - 1; i < n; ++i)
+    {
+        g += (x[i] - 0.5) * (x[i] - 0.5);
+    }
+    dtlz_sphere<m>(g, x, f);
+}
+
+template <int m>
+inline void DTLZ3(int n, const double *x, double *f)
+{
+    int k = n - m + 1;
+    double g = 0;
+    for (int i = m - 1; i < n; ++i)
+    {
+        g += (x[i] - 0.5) * (x[i] - 0.5) - cos(20 * PI * (x[i] - 0.5));
+    }
+    g = 100 * (k + g);
+    dtlz_sphere<m>(g, x, f);
+}
+
+template <int m>
+inline void DTLZ4(int n, const double *x, double *f)
+{
+    double y[m];
+    for (int i = 0; i < m - 1; ++i)
+    {
+        y[i] = pow(x[i], 100);
+    }
+    double g = 0;
+    for (int i = m - 1; i < n; ++i)
+    {
+        double yi = pow(x[i], 100);
+        g += (yi - 0.5) * (yi - 0.5);
+    }
+    dtlz_sphere<m>(g, y, f);
+}
+
+template <int m>
+inline void DTLZ5(int n, const double *x, double *f)
+{
+    double g = 0;
+    for (int i = m - 1; i < n; ++i)
+    {
+        g += pow(x[i], 0.1);
+    }
+
+    // theta_i for i = 1 .. m - 2, the first angle being pi / 2 x_0
+    double h = (1 + g) * cos(0.5 * PI * x[0]), prod = 1;
+    for (int i = m - 2; i > 0; --i)
+    {
+        double theta = (PI / 2) * (1 + 2 * g * x[m - 1 - i]) / (2 * (1 + g));
+        f[i] = h * prod * sin(theta);
+        prod *= cos(theta);
+    }
+    f[0] = h * prod;
+    f[m - 1] = (1 + g) * sin(0.5 * PI * x[0]);
+}
+
+template <int m>
+inline void DTLZ6(int n, const double *x, double *f)
+{
+    int k = n - m + 1;
+    double g = 0;
+    for (int i = m - 1; i < n; ++i)
+    {
+        g += x[i];
+    }
+    g = 1 + (9.0 / k) * g;
+
+    double sum = 0;
+    for (int i = 0; i < m - 1; ++i)
+    {
+        f[i] = x[i];
+        sum += x[i] / (1 + g) * (1 + sin(3 * PI * x[i]));
+    }
+    f[m - 1] = (1 + g) * (m - sum);
+}
+
+// objectives of DTLZ<variant> (1 .. 6) for mm objectives (2 .. DTLZ_MAX_OBJECTIVES)
+template <int m = 2>
+inline ObjectiveFunction dtlz_objectives(int variant, int mm, int n)
+{
+    if constexpr (m < DTLZ_MAX_OBJECTIVES)
+    {
+        if (mm != m)
+            return dtlz_objectives<m + 1>(variant, mm, n);
+    }
+    switch (variant)
+    {
+    case 1:
+        return [n](const double *x, double *f) { DTLZ1<m>(n, x, f); };
+    case 2:
+        return [n](const double *x, double *f) { DTLZ2<m>(n, x, f); };
+    case 3:
+        return [n](const double *x, double *f) { DTLZ3<m>(n, x, f); };
+    case 4:
+        return [n](const double *x, double *f) { DTLZ4<m>(n, x, f); };
+    case 5:
+        return [n](const double *x, double *f) { DTLZ5<m>(n, x, f); };
+    default:
+        return [n](const double *x, double *f) { DTLZ6<m>(n, x, f); };
+    }
+}
+
+// k of DTLZ<variant> in problems/julia
+inline int dtlz_default_k(int variant)
+{
+    return variant == 1 ? 5 : (variant == 6 ? 20 : 10);
+}
+
+// the canonical name of DTLZ<variant> with m objectives and n variables
+inline std::string dtlz_name(int variant, int m, int n)
+{
+    std::string base = "DTLZ" + std::to_string(variant);
+    if (m == 2 && n == 2)
+        return base + "n2";
+    if (m == 3 && n == m + dtlz_default_k(variant) - 1)
+        return base;
+    if (n == m + dtlz_default_k(variant) - 1)
+        return base + "-m" + std::to_string(m);
+    return base + "-m" + std::to_string(m) + "-n" + std::to_string(n);
+}
+
+// variant, m and n of a DTLZ name, false if name is not one (or not in
+// the canonical form given by dtlz_name)
+inline bool parse_dtlz_name(const std::string &name, int &variant, int &m, int &n)
+{
+    if (name.size() < 5 || name.compare(0, 4, "DTLZ") != 0 || name[4] < '1' || name[4] > '6')
+        return false;
+    variant = name[4] - '0';
+    std::string rest = name.substr(5);
+    m = 3;
+    n = m + dtlz_default_k(variant) - 1;
+    if (rest == "n2")
+        m = n = 2;
+    else if (!rest.empty())
+    {
+        char *end;
+        if (rest.compare(0, 2, "-m") != 0)
+            return false;
+        m = static_cast<int>(std::strtol(rest.c_str() + 2, &end, 10));
+        n = m + dtlz_default_k(variant) - 1;
+        if (*end == '-' && end[1] == 'n')
+            n = static_cast<int>(std::strtol(end + 2, &end, 10));
+        if (*end != '\0')
+            return false;
+    }
+    return m >= 2 && m <= DTLZ_MAX_OBJECTIVES && n >= m && name == dtlz_name(variant, m, n);
+}
+
+inline Problem dtlz_problem(int variant, int m, int n)
+{
+    return Problem{dtlz_name(variant, m, n), n, m, 1, bounds(n, 0.0), bounds(n, 1.0), dtlz_objectives(variant, m, n)};
+}
+
+/*----------------------------------------*/
+/*              WFG toolkit               */
+/*----------------------------------------*/
+//
+// WFG1-9 of problems/julia (Huband et al., A review of multiobjective test
+// problems and a scalable test problem toolkit, IEEE TEC 10(5), 2006):
+// M = 3 objectives, k = 4 position and l = 4 distance parameters, x_i in
+// [0, 2 i]. Each problem normalizes y_i = x_i / (2 i), chains the
+// transformations of namespace wfg (names of the paper) on the vector of
+// values, reduces it to M values t and, with the degeneracy constants A_j
+// (1, except A_2 = 0 for WFG3),
+//   x_j = max(t_M, A_j) (t_j - 0.5) + 0.5 for j < M, x_M = t_M,
+//   f_j = x_M + 2 j h_j(x_1 .. x_M-1), h the shape of the problem.
+// The expressions, their order and the denominators of r_nonsep are those
+// of the Julia functions. The batched kernels (wfg_kernels.inc) run the
+// same transformations as stages over packs of points. Like the DTLZ
+// problems, they are not in all_problems; find_problem builds them from
+// their name.
+
+const int WFG_M = 3;
+const int WFG_K = 4;
+const int WFG_L = 4;
+const int WFG_N = WFG_K + WFG_L;
+
+namespace wfg
+{
+
+// weights of the means of WFG2-9
+const double ONES[WFG_N] = {1, 1, 1, 1, 1, 1, 1, 1};
+
+// shifts
+inline double s_linear(double y, double A)
+{
+    return fabs(y - A) / fabs(floor(A - y) + A);
+}
+
+inline double s_decept(double y, double A, double B, double C)
+{
+    return 1 + (fabs(y - A) - B) * ((floor(y - A + B) * (1 - C + (A - B) / B)) / (A - B) +
+                                    (floor(A + B - y) * (1 - C + (1 - A - B) / B)) / (1 - A - B) + 1 / B);
+}
+
+inline double s_multi(double y, double A, double B, double C)
+{
+    double r = fabs(y - C) / (2 * (floor(C - y) + C));
+    return (1 + cos((4 * A + 2) * PI * (0.5 - r)) + 4 * B * (r * r)) / (B + 2);
+}
+
+// biases; u of b_param is a mean of other values (r_sum)
+inline double b_flat(double y, double A, double B, double C)
+{
+    return A + fmin(0, floor(y - B)) * (A * (B - y)) / B - fmin(0, floor(C - y)) * (1 - A) * (y - C) / (1 - C);
+}
+
+inline double b_poly(double y, double alpha)
+{
+    return pow(fabs(y), alpha);
+}
+
+inline double b_param(double y, double u, double A, double B, double C)
+{
+    return pow(y, B + (C - B) * (A - (1 - 2 * u) * fabs(floor(0.5 - u) + A)));
+}
+
+// reductions: weighted mean of y[from .. to - 1], and the non-separable
+// reduction of degree A of y[0 .. len - 1]
+inline double r_sum(const double *y, const double *w, int from, int to)
+{
+    double num = 0, den = 0;
+    for (int i = from; i < to; ++i)
+    {
+        num += w[i] * y[i];
+        den += w[i];
+    }
+    return num / den;
+}
+
+inline double r_nonsep(const double *y, int len, int A)
+{
+    double r = 0;
+    for (int j = 0; j < len; ++j)
+    {
+        r += y[j];
+        for (int q = 0; q < A - 1; ++q)
+        {
+            r += fabs(y[j] - y[(j + q + 1) % len]);
+        }
+    }
+    double c = ceil(A / 2.0);
+    return r / (static_cast<double>(len) / A * c * (1 + 2 * A - 2 * c));
+}
+
+// t_1 .. t_M: r_sum of the M - 1 groups of position parameters and of the
+// distance parameters y[WFG_K .. len - 1] (len = WFG_N, or WFG_K + WFG_L / 2
+// after the pairs of WFG2 and WFG3)
+inline void r_sum_groups(const double *y, const double *w, int len, double *t)
+{
+    for (int j = 0; j < WFG_M - 1; ++j)
+    {
+        t[j] = r_sum(y, w, j * WFG_K / (WFG_M - 1), (j + 1) * WFG_K / (WFG_M - 1));
+    }
+    t[WFG_M - 1] = r_sum(y, w, WFG_K, len);
+}
+
+// the same with r_nonsep, of degree the size of each group
+inline void r_nonsep_groups(const double *y, double *t)
+{
+    const int G = WFG_K / (WFG_M - 1);
+    for (int j = 0; j < WFG_M - 1; ++j)
+    {
+        t[j] = r_nonsep(y + j * G, G, G);
+    }
+    t[WFG_M - 1] = r_nonsep(y + WFG_K, WFG_L, WFG_L);
+}
+
+// shapes: h_1 .. h_M-1 (convex, the M-th being mixed or disc) or h_1 .. h_M
+// of x_1 .. x_M-1
+inline void convex(const double *x, double *h)
+{
+    for (int j = 0; j < WFG_M - 1; ++j)
+    {
+        double prod = 1;
+        for (int i = 0; i < WFG_M - 1 - j; ++i)
+        {
+            prod *= 1 - cos((PI / 2) * x[i]);
+        }
+        h[j] = j == 0 ? prod : prod * (1 - sin(x[WFG_M - 1 - j] * (PI / 2)));
+    }
+}
+
+inline double mixed(const double *x, int A)
+{
+    return 1 - x[0] - cos(2 * A * PI * x[0] + PI / 2) / (2 * A * PI);
+}
+
+inline double disc(const double *x, int A)
+{
+    double c = cos(A * x[0] * PI);
+    return 1 - x[0] * (c * c);
+}
+
+inline void linear(const double *x, double *h)
+{
+    for (int j = 0; j < WFG_M; ++j)
+    {
+        double prod = 1;
+        for (int i = 0; i < WFG_M - 1 - j; ++i)
+        {
+            prod *= x[i];
+        }
+        h[j] = j == 0 ? prod : prod * (1 - x[WFG_M - 1 - j]);
+    }
+}
+
+inline void concave(const double *x, double *h)
+{
+    for (int j = 0; j < WFG_M; ++j)
+    {
+        double prod = 1;
+        for (int i = 0; i < WFG_M - 1 - j; ++i)
+        {
+            prod *= sin(x[i] * (PI / 2));
+        }
+        h[j] = j == 0 ? prod : prod * cos(x[WFG_M - 1 - j] * (PI / 2));
+    }
+}
+
+// x_1 .. x_M of t_1 .. t_M, A_j = 1 except A_2 = 0 when a2 is false
+inline void degenerate(const double *t, bool a2, double *x)
+{
+    for (int j = 0; j < WFG_M - 1; ++j)
+    {
+        x[j] = fmax(t[WFG_M - 1], j == 1 && !a2 ? 0.0 : 1.0) * (t[j] - 0.5) + 0.5;
+    }
+    x[WFG_M - 1] = t[WFG_M - 1];
+}
+
+// f_j = x_M + 2 j h_j
+inline void scale(const double *x, const double *h, double *f)
+{
+    for (int j = 0; j < WFG_M; ++j)
+    {
+        f[j] = x[WFG_M - 1] + 2 * (j + 1) * h[j];
+    }
+}
+
+inline void normalize(const double *x, double *y)
+{
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        y[i] = x[i] / (2 * (i + 1));
+    }
+}
+
+// b_param of y[from .. to - 1] with u the mean of y[i + 1 .. WFG_N - 1]
+// (after) or of y[0 .. i - 1]
+inline void b_param_range(const double *y, int from, int to, bool after, double *t)
+{
+    for (int i = from; i < to; ++i)
+    {
+        double u = after ? r_sum(y, ONES, i + 1, WFG_N) : r_sum(y, ONES, 0, i);
+        t[i] = b_param(y[i], u, 0.98 / 49.98, 0.02, 50);
+    }
+}
+
+} // namespace wfg
+
+inline void WFG1(const double *x, double *f)
+{
+    double t[WFG_N], w[WFG_N];
+    wfg::normalize(x, t);
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        w[i] = 2 * (i + 1);
+        if (i >= WFG_K)
+            t[i] = wfg::b_flat(wfg::s_linear(t[i], 0.35), 0.8, 0.75, 0.85);
+        t[i] = wfg::b_poly(t[i], 0.02);
+    }
+    double r[WFG_M], xs[WFG_M], h[WFG_M];
+    wfg::r_sum_groups(t, w, WFG_N, r);
+    wfg::degenerate(r, true, xs);
+    wfg::convex(xs, h);
+    h[WFG_M - 1] = wfg::mixed(xs, 5);
+    wfg::scale(xs, h, f);
+}
+
+// WFG2 and WFG3: r_nonsep of the pairs of distance parameters
+inline void wfg_nonsep_pairs(const double *x, double *t)
+{
+    wfg::normalize(x, t);
+    for (int i = WFG_K; i < WFG_N; ++i)
+    {
+        t[i] = wfg::s_linear(t[i], 0.35);
+    }
+    for (int i = 0; i < WFG_L / 2; ++i)
+    {
+        t[WFG_K + i] = wfg::r_nonsep(t + WFG_K + 2 * i, 2, 2);
+    }
+}
+
+inline void WFG2(const double *x, double *f)
+{
+    double t[WFG_N], r[WFG_M], xs[WFG_M], h[WFG_M];
+    wfg_nonsep_pairs(x, t);
+    wfg::r_sum_groups(t, wfg::ONES, WFG_K + WFG_L / 2, r);
+    wfg::degenerate(r, true, xs);
+    wfg::convex(xs, h);
+    h[WFG_M - 1] = wfg::disc(xs, 5);
+    wfg::scale(xs, h, f);
+}
+
+inline void WFG3(const double *x, double *f)
+{
+    double t[WFG_N], r[WFG_M], xs[WFG_M], h[WFG_M];
+    wfg_nonsep_pairs(x, t);
+    wfg::r_sum_groups(t, wfg::ONES, WFG_K + WFG_L / 2, r);
+    wfg::degenerate(r, false, xs);
+    wfg::linear(xs, h);
+    wfg::scale(xs, h, f);
+}
+
+// WFG4 .. WFG9 end with the concave shape of the reduced t
+inline void wfg_concave(const double *r, double *f)
+{
+    double xs[WFG_M], h[WFG_M];
+    wfg::degenerate(r, true, xs);
+    wfg::concave(xs, h);
+    wfg::scale(xs, h, f);
+}
+
+inline void WFG4(const double *x, double *f)
+{
+    double t[WFG_N], r[WFG_M];
+    wfg::normalize(x, t);
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        t[i] = wfg::s_multi(t[i], 30, 10, 0.35);
+    }
+    wfg::r_sum_groups(t, wfg::ONES, WFG_N, r);
+    wfg_concave(r, f);
+}
+
+inline void WFG5(const double *x, double *f)
+{
+    double t[WFG_N], r[WFG_M];
+    wfg::normalize(x, t);
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        t[i] = wfg::s_decept(t[i], 0.35, 0.001, 0.05);
+    }
+    wfg::r_sum_groups(t, wfg::ONES, WFG_N, r);
+    wfg_concave(r, f);
+}
+
+inline void WFG6(const double *x, double *f)
+{
+    double t[WFG_N], r[WFG_M];
+    wfg::normalize(x, t);
+    for (int i = WFG_K; i < WFG_N; ++i)
+    {
+        t[i] = wfg::s_linear(t[i], 0.35);
+    }
+    wfg::r_nonsep_groups(t, r);
+    wfg_concave(r, f);
+}
+
+// WFG7 (position parameters biased by the mean of the next ones) and WFG8
+// (distance parameters by the mean of the previous ones)
+inline void wfg_param_linear(const double *x, bool wfg7, double *f)
+{
+    double y[WFG_N], t[WFG_N], r[WFG_M];
+    wfg::normalize(x, y);
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        t[i] = y[i];
+    }
+    if (wfg7)
+        wfg::b_param_range(y, 0, WFG_K, true, t);
+    else
+        wfg::b_param_range(y, WFG_K, WFG_N, false, t);
+    for (int i = WFG_K; i < WFG_N; ++i)
+    {
+        t[i] = wfg::s_linear(t[i], 0.35);
+    }
+    wfg::r_sum_groups(t, wfg::ONES, WFG_N, r);
+    wfg_concave(r, f);
+}
+
+inline void WFG7(const double *x, double *f)
+{
+    wfg_param_linear(x, true, f);
+}
+
+inline void WFG8(const double *x, double *f)
+{
+    wfg_param_linear(x, false, f);
+}
+
+inline void WFG9(const double *x, double *f)
+{
+    double y[WFG_N], t[WFG_N], r[WFG_M];
+    wfg::normalize(x, y);
+    t[WFG_N - 1] = y[WFG_N - 1];
+    wfg::b_param_range(y, 0, WFG_N - 1, true, t);
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        t[i] = i < WFG_K ? wfg::s_decept(t[i], 0.35, 0.001, 0.05) : wfg::s_multi(t[i], 30, 95, 0.35);
+    }
+    wfg::r_nonsep_groups(t, r);
+    wfg_concave(r, f);
+}
+
+// variant (1 .. 9) of a WFG name, 0 if name is not one
+inline int parse_wfg_name(const std::string &name)
+{
+    return name.size() == 4 && name.compare(0, 3, "WFG") == 0 && name[3] >= '1' && name[3] <= '9' ? name[3] - '0' : 0;
+}
+
+// bounds of get_pb_data_infos: x_i in [0, 2 i]
+inline Problem wfg_problem(int variant)
+{
+    static const ObjectiveFunction functions[9] = {WFG1, WFG2, WFG3, WFG4, WFG5, WFG6, WFG7, WFG8, WFG9};
+    std::vector<double> ub(WFG_N);
+    for (int i = 0; i < WFG_N; ++i)
+    {
+        ub[i] = 2.0 * (i + 1);
+    }
+    return Problem{"WFG" + std::to_string(variant), WFG_N, WFG_M, 1, bounds(WFG_N, 0.0), ub, functions[variant - 1]};
+}
+
+// nullptr if the problem is unknown
+inline const Problem *find_problem(const std::string &name)
+{
+    for (const Problem &pb : all_problems())
+    {
+        if (pb.name == name)
+            return &pb;
+    }
+
+    // DTLZ and WFG problems and <base>-n<n>-s<seed>, built once and kept
+    // for the lifetime of the process
+    int variant = 0, m = 0, n_dtlz = 0;
+    bool dtlz = parse_dtlz_name(name, variant, m, n_dtlz);
+    int wfg = parse_wfg_name(name);
+    size_t dn = name.find("-n"), ds = name.find("-s", dn == std::string::npos ? 0 : dn);
+    long n = 0;
+    uint64_t seed = 0;
+    if (!dtlz && wfg == 0)
+    {
+        if (dn == std::string::npos || ds == std::string::npos || !is_scalable_base(name.substr(0, dn)))
+            return nullptr;
+        char *end;
+        n = std::strtol(name.c_str() + dn + 2, &end, 10);
+        if (end != name.c_str() + ds || n < 2)
+            return nullptr;
+        seed = std::strtoull(name.c_str() + ds + 2, &end, 10);
+        if (*end != '\0' || ds + 2 == name.size() || name != scalable_name(name.substr(0, dn), n, seed))
+            return nullptr;
+    }
+
+    static std::deque<Problem> built;
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> guard(mtx);
+    for (const Problem &pb : built)
+    {
+        if (pb.name == name)
+            return &pb;
+    }
+    if (dtlz)
+        built.push_back(dtlz_problem(variant, m, n_dtlz));
+    else if (wfg > 0)
+        built.push_back(wfg_problem(wfg));
+    else
+        built.push_back(scalable_problem(name.substr(0, dn), static_cast<int>(n), seed));
+    return &built.back();
+}
+
+// problem name as written in problems/julia and problems/matlab, for the
+// Julia harness: L2ZDT1 takes M30 there (the drivers round 3 values of its
+// last row), the other problems are those of find_problem
+inline const Problem *find_harness_problem(const std::string &name)
+{
+    static const std::vector<Problem> harness = []()
+    {
+        std::vector<Problem> list;
+        for (const DslDeclaration &d : dsl_harness_declarations())
+            list.push_back(declared_problem(d));
+        return list;
+    }();
+    for (const Problem &pb : harness)
+    {
+        if (pb.name == name)
+            return &pb;
+    }
+    return find_problem(name);
+}
+
+// the n starting points of the drivers: x0_j = lb + j (ub - lb) / (n - 1)
+inline std::vector<std::vector<double>> starting_points(const Problem &pb)
+{
+    return diagonal_starting_points(pb.lb, pb.ub);
+}
+
+} // namespace bbproblems
+
+#endif
@@ -0,0 +1,387 @@
+#ifndef ROTATION_CACHE_HPP
+#define ROTATION_CACHE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "rotation_matrices.hpp"
+#include "structured_rotation.hpp"
+
+/*-----------------------------------------------------------------*/
+/*    Generated rotation matrices and their memory-mapped cache    */
+/*-----------------------------------------------------------------*/
+//
+// Generators, by name:
+//  - A10, D10, M30, M30_L2ZDT1: the matrices of rotation_matrices.hpp. All
+//    are views of one sequence s of 900 values, the rows of M30:
+//      A10[i][j] = s[10 i + j];
+//      D10[0][0] = 1, D10[i][j] = s[10 i + j + 1] for i, j >= 1, else 0;
+//      M30_L2ZDT1 = M30 except 3 values of the last row, rounded to fewer
+//      digits (the copy of L2ZDT1 in the drivers; L2ZDT1.jl and L2ZDT1.m
+//      use M30).
+//    s is the canonical table: it was not drawn from a known seed, so it
+//    cannot be regenerated;
+//  - givens-n<n>-s<seed>: the StructuredRotation of size n and seed
+//    (orthogonal, see structured_rotation.hpp);
+//  - uniform-n<n>-s<seed>: n x n entries 2u - 1 (like the literals, not
+//    orthogonal), u = splitmix_uniform of the seed, row by row.
+//
+// Cache file, read by load_rotation of problems/julia and problems/matlab:
+//
+//   header | entries | matrices
+//
+// header: magic "BBROTMAT", uint32 version (1), uint32 count; then count
+// entries of 64 bytes: char name[40] (0-padded), uint32 rows, uint32 cols,
+// uint64 offset of the matrix in the file (multiple of 64), uint64
+// FNV-1a hash of its bytes. Matrices are row-major little-endian doubles.
+// The file is written once (to a temporary file then renamed) and mapped
+// read-only by the readers.
+//
+// The problems of problems.hpp, generated from the declarations of
+// dsl_problems.inc, take A10, D10, M30 and M30_L2ZDT1 from the file named by
+// $BBPROBLEMS_ROTATION_CACHE when it is set (rotation_A10()... below), else
+// from the literals, which stay the canonical table.
+
+namespace bbproblems
+{
+
+struct RotationMatrix
+{
+    std::string name;
+    int rows = 0;
+    int cols = 0;
+    std::vector<double> values; // row-major
+};
+
+/*----------------------------------------*/
+/*               generators               */
+/*----------------------------------------*/
+
+// name of a generated matrix, "givens" or "uniform"
+inline std::string rotation_name(const std::string &kind, int n, uint64_t seed)
+{
+    return kind + "-n" + std::to_string(n) + "-s" + std::to_string(seed);
+}
+
+// throws if name is none of the above
+inline RotationMatrix generate_rotation(const std::string &name)
+{
+    RotationMatrix r;
+    r.name = name;
+    const double *s = &MATRIX_M30[0][0];
+    if (name == "A10" || name == "D10")
+    {
+        r.rows = r.cols = 10;
+        bool d = (name == "D10");
+        for (int i = 0; i < 10; ++i)
+        {
+            for (int j = 0; j < 10; ++j)
+            {
+                if (!d)
+                    r.values.push_back(s[10 * i + j]);
+                else
+                    r.values.push_back((i == 0 || j == 0) ? (i == j) : s[10 * i + j + 1]);
+            }
+        }
+        return r;
+    }
+    if (name == "M30" || name == "M30_L2ZDT1")
+    {
+        r.rows = r.cols = 30;
+        r.values.assign(s, s + 900);
+        if (name == "M30_L2ZDT1")
+        {
+            r.values[29 * 30 + 14] = -0.037995;
+            r.values[29 * 30 + 24] = 0.096428;
+            r.values[29 * 30 + 29] = -0.72035;
+        }
+        return r;
+    }
+
+    size_t dn = name.find("-n"), ds = name.find("-s", dn == std::string::npos ? 0 : dn);
+    std::string kind = name.substr(0, dn);
+    if (dn != std::string::npos && ds != std::string::npos && (kind == "givens" || kind == "uniform"))
+    {
+        int n = std::atoi(name.c_str() + dn + 2);
+        uint64_t seed = std::strtoull(name.c_str() + ds + 2, nullptr, 10);
+        if (n >= 1 && name == rotation_name(kind, n, seed))
+        {
+            r.rows = r.cols = n;
+            if (kind == "givens")
+            {
+                r.values = StructuredRotation(n, seed).dense();
+            }
+            else
+            {
+                uint64_t state = seed;
+                r.values.resize(static_cast<size_t>(n) * n);
+                for (double &v : r.values)
+                {
+                    v = 2 * splitmix_uniform(state) - 1;
+                }
+            }
+            return r;
+        }
+    }
+    throw std::runtime_error("unknown rotation matrix " + name);
+}
+
+/*----------------------------------------*/
+/*               cache file               */
+/*----------------------------------------*/
+
+class RotationCache
+{
+public:
+    struct Entry
+    {
+        char name[40];
+        uint32_t rows;
+        uint32_t cols;
+        uint64_t offset;
+        uint64_t hash;
+    };
+
+    static constexpr char MAGIC[8] = {'B', 'B', 'R', 'O', 'T', 'M', 'A', 'T'};
+    static const uint32_t VERSION = 1;
+
+    static uint64_t fnv1a(const void *data, size_t size)
+    {
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (size_t k = 0; k < size; ++k)
+        {
+            h = (h ^ p[k]) * 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    // writes the matrices to path (replaced atomically)
+    static void write(const std::string &path, const std::vector<RotationMatrix> &matrices)
+    {
+        size_t offset = (16 + 64 * matrices.size() + 63) / 64 * 64;
+        std::vector<Entry> entries(matrices.size());
+        for (size_t k = 0; k < matrices.size(); ++k)
+        {
+            const RotationMatrix &r = matrices[k];
+            if (r.name.size() >= sizeof(entries[k].name) ||
+                r.values.size() != static_cast<size_t>(r.rows) * r.cols)
+                throw std::runtime_error("invalid rotation matrix " + r.name);
+            std::memset(&entries[k], 0, sizeof(Entry));
+            std::memcpy(entries[k].name, r.name.data(), r.name.size());
+            entries[k].rows = static_cast<uint32_t>(r.rows);
+            entries[k].cols = static_cast<uint32_t>(r.cols);
+            entries[k].offset = offset;
+            entries[k].hash = fnv1a(r.values.data(), r.values.size() * sizeof(double));
+            offset += (r.values.size() * sizeof(double) + 63) / 64 * 64;
+        }
+
+        std::vector<char> buf(offset, 0);
+        uint32_t head[2] = {VERSION, static_cast<uint32_t>(matrices.size())};
+        std::memcpy(buf.data(), MAGIC, sizeof(MAGIC));
+        std::memcpy(buf.data() + 8, head, sizeof(head));
+        for (size_t k = 0; k < matrices.size(); ++k)
+        {
+            std::memcpy(buf.data() + 16 + 64 * k, &entries[k], sizeof(Entry));
+            std::memcpy(buf.data() + entries[k].offset, matrices[k].values.data(),
+                        matrices[k].values.size() * sizeof(double));
+        }
+
+        std::string tmp = path + ".tmp" + std::to_string(getpid());
+        int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            throw std::runtime_error("cannot write " + tmp);
+        size_t done = 0;
+        while (done < buf.size())
+        {
+            ssize_t w = ::write(fd, buf.data() + done, buf.size() - done);
+            if (w <= 0)
+            {
+                close(fd);
+                unlink(tmp.c_str());
+                throw std::runtime_error(tmp + ": write error");
+            }
+            done += static_cast<size_t>(w);
+        }
+        close(fd);
+        if (rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            unlink(tmp.c_str());
+            throw std::runtime_error("cannot rename " + tmp + " to " + path);
+        }
+    }
+
+private:
+    std::string path;
+    const char *base = nullptr;
+    size_t size = 0;
+    std::map<std::string, Entry> index;
+
+public:
+    explicit RotationCache(const std::string &filename) : path(filename)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open rotation cache " + filename);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 16)
+        {
+            close(fd);
+            throw std::runtime_error(filename + ": not a rotation cache");
+        }
+        size = static_cast<size_t>(st.st_size);
+        void *mem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED)
+            throw std::runtime_error("cannot map " + filename);
+        base = static_cast<const char *>(mem);
+
+        uint32_t head[2];
+        std::memcpy(head, base + 8, sizeof(head));
+        if (std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0 || head[0] != VERSION || 16 + 64 * size_t(head[1]) > size)
+        {
+            munmap(const_cast<char *>(base), size);
+            throw std::runtime_error(filename + ": not a rotation cache (version 1)");
+        }
+        for (uint32_t k = 0; k < head[1]; ++k)
+        {
+            Entry e;
+            std::memcpy(&e, base + 16 + 64 * size_t(k), sizeof(Entry));
+            e.name[sizeof(e.name) - 1] = '\0';
+            if (e.offset % 64 != 0 || e.offset + sizeof(double) * e.rows * e.cols > size)
+            {
+                munmap(const_cast<char *>(base), size);
+                throw std::runtime_error(filename + ": matrix " + e.name + " beyond the end of the file");
+            }
+            index[e.name] = e;
+        }
+    }
+
+    ~RotationCache()
+    {
+        if (base != nullptr)
+            munmap(const_cast<char *>(base), size);
+    }
+
+    RotationCache(const RotationCache &) = delete;
+    RotationCache &operator=(const RotationCache &) = delete;
+
+    std::vector<std::string> names() const
+    {
+        std::vector<std::string> res;
+        for (const auto &kv : index)
+        {
+            res.push_back(kv.first);
+        }
+        return res;
+    }
+
+    // row-major matrix in the mapping, nullptr if absent
+    const double *find(const std::string &name, int &rows, int &cols) const
+    {
+        auto it = index.find(name);
+        if (it == index.end())
+            return nullptr;
+        rows = static_cast<int>(it->second.rows);
+        cols = static_cast<int>(it->second.cols);
+        return reinterpret_cast<const double *>(base + it->second.offset);
+    }
+
+    // true if the bytes of the matrix still match the hash of its entry
+    bool verify(const std::string &name) const
+    {
+        auto it = index.find(name);
+        if (it == index.end())
+            return false;
+        const Entry &e = it->second;
+        return fnv1a(base + e.offset, sizeof(double) * e.rows * e.cols) == e.hash;
+    }
+};
+
+/*----------------------------------------*/
+/*        matrices of the problems        */
+/*----------------------------------------*/
+
+// Matrix name of the cache file named by $BBPROBLEMS_ROTATION_CACHE, mapped
+// once per process; nullptr without the variable, or if the matrix is
+// absent, of another size or altered (then reported once on stderr).
+inline const double *cached_rotation(const std::string &name, int rows, int cols)
+{
+    static const std::unique_ptr<RotationCache> cache = []()
+    {
+        std::unique_ptr<RotationCache> res;
+        const char *path = std::getenv("BBPROBLEMS_ROTATION_CACHE");
+        if (path == nullptr || *path == '\0')
+            return res;
+        try
+        {
+            res.reset(new RotationCache(path));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "warning: " << e.what() << ", the rotation matrices are the literals" << std::endl;
+        }
+        return res;
+    }();
+    if (!cache)
+        return nullptr;
+
+    int r = 0, c = 0;
+    const double *values = cache->find(name, r, c);
+    if (values != nullptr && r == rows && c == cols && cache->verify(name))
+        return values;
+    std::cerr << "warning: no valid " << rows << " x " << cols << " matrix " << name
+              << " in the rotation cache, the literal is used" << std::endl;
+    return nullptr;
+}
+
+template <int n>
+using RotationRows = const double (*)[n];
+
+// the matrix of the cache if it has it, else the literal
+template <int n>
+inline RotationRows<n> shared_rotation(const std::string &name, RotationRows<n> literal)
+{
+    const double *values = cached_rotation(name, n, n);
+    return values != nullptr ? reinterpret_cast<RotationRows<n>>(values) : literal;
+}
+
+// Matrices used by the problems, resolved once: problems.hpp and the batched
+// kernels read them here rather than the literals of rotation_matrices.hpp.
+inline RotationRows<10> rotation_A10()
+{
+    static const RotationRows<10> m = shared_rotation<10>("A10", MATRIX_A10);
+    return m;
+}
+
+inline RotationRows<10> rotation_D10()
+{
+    static const RotationRows<10> m = shared_rotation<10>("D10", MATRIX_D10);
+    return m;
+}
+
+inline RotationRows<30> rotation_M30()
+{
+    static const RotationRows<30> m = shared_rotation<30>("M30", MATRIX_M30);
+    return m;
+}
+
+inline RotationRows<30> rotation_M30_L2ZDT1()
+{
+    static const RotationRows<30> m = shared_rotation<30>("M30_L2ZDT1", MATRIX_M30_L2ZDT1);
+    return m;
+}
+
+} // namespace bbproblems
+
+#endif
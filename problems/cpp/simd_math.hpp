@@ -0,0 +1,441 @@
+#ifndef SIMD_MATH_HPP
+#define SIMD_MATH_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#define BBPROBLEMS_X86
+#include <immintrin.h>
+#endif
+
+/*-----------------------------------------------------------------*/
+/*     Vectorized sin, cos, exp, log and pow for batched kernels   */
+/*-----------------------------------------------------------------*/
+//
+// The functions are written once (simd_math.inc) on a pack type P, which
+// gives the vector type P::V of P::width doubles and the few instructions
+// they need, and compiled once per instruction set in namespace
+// simd::<isa>, under "#pragma GCC target" of that instruction set:
+//  - scalar: one double; sin, cos, exp, log and pow are those of libm, so
+//    that kernels built on it give the values of problems.hpp;
+//  - sse42 (2 doubles), avx2 (AVX2 + FMA, 4 doubles) and avx512
+//    (AVX-512F, 8 doubles): fdlibm algorithms (argument reduction, then the
+//    polynomials of __kernel_sin, __kernel_cos, e_exp and e_log) on all
+//    lanes at once.
+// One binary thus holds every variant and the best one of the CPU is
+// chosen at run time (active_isa, detected with __builtin_cpu_supports,
+// or forced with force_isa, e.g. by an --isa option). Compile without
+// -march=native for a binary running on older CPUs: the pragmas only add
+// instructions to those of the command line.
+//
+// The arithmetic operators of P::V are those of GCC vector extensions.
+// Maximum errors of the vector packs, in ulp of the exact result (checked
+// against long double by simd_math_check):
+//   sin, cos   |x| <= 100                   1.5 ulp
+//              |x| <= 1e6                   2.5 ulp (libm lane by lane beyond)
+//   exp        all x                        1 ulp (subnormal results: 1 ulp
+//                                           of the smallest normal)
+//   log        x > 0                        1 ulp
+//   pow(x, p)  x >= 0, normal result        2 ulp (p a double, or a
+//                                           vector of p > 0 lane by lane)
+// Special values follow libm (NaN in, NaN out; exp(-inf) = 0, log(0) =
+// -inf, log(x < 0) = NaN, pow(0, p > 0) = 0).
+
+namespace bbproblems
+{
+namespace simd
+{
+
+enum Isa
+{
+    ISA_SCALAR,
+    ISA_SSE42,
+    ISA_AVX2,
+    ISA_AVX512
+};
+
+const int NB_ISAS = 4;
+
+enum MathFunction
+{
+    SIN,
+    COS,
+    EXP,
+    LOG,
+    POW
+};
+
+// t = x + MAGIC rounds x to the nearest integer k (|x| < 2^51), kept in the
+// low bits of the representation of t
+const double MAGIC = 0x1.8p52;
+
+const double SINCOS_MAX = 1e6; // |n| < 2^20: n * PIO2_1 is exact
+
+/*----------------------------------------*/
+/*           instruction sets             */
+/*----------------------------------------*/
+
+inline const char *isa_name(Isa isa)
+{
+    static const char *names[NB_ISAS] = {"scalar", "sse42", "avx2", "avx512"};
+    return names[isa];
+}
+
+inline Isa parse_isa(const std::string &name)
+{
+    for (int i = 0; i < NB_ISAS; ++i)
+    {
+        if (name == isa_name(static_cast<Isa>(i)))
+            return static_cast<Isa>(i);
+    }
+    throw std::runtime_error("unknown instruction set " + name + " (scalar, sse42, avx2 or avx512)");
+}
+
+inline bool cpu_supports(Isa isa)
+{
+#ifdef BBPROBLEMS_X86
+    __builtin_cpu_init();
+    switch (isa)
+    {
+    case ISA_SSE42:
+        return __builtin_cpu_supports("sse4.2");
+    case ISA_AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case ISA_AVX512:
+        return __builtin_cpu_supports("avx512f");
+    default:
+        return true;
+    }
+#else
+    return isa == ISA_SCALAR;
+#endif
+}
+
+// widest instruction set of the CPU
+inline Isa detected_isa()
+{
+    for (int i = NB_ISAS - 1; i > 0; --i)
+    {
+        if (cpu_supports(static_cast<Isa>(i)))
+            return static_cast<Isa>(i);
+    }
+    return ISA_SCALAR;
+}
+
+struct IsaChoice
+{
+    Isa isa;
+    bool forced;
+};
+
+inline IsaChoice &isa_choice()
+{
+    static IsaChoice choice = {detected_isa(), false};
+    return choice;
+}
+
+// instruction set of the batched kernels
+inline Isa active_isa()
+{
+    return isa_choice().isa;
+}
+
+// uses isa instead of the detected one (benchmarks); throws if the CPU
+// does not support it
+inline void force_isa(Isa isa)
+{
+    if (!cpu_supports(isa))
+        throw std::runtime_error(std::string("the CPU does not support ") + isa_name(isa));
+    isa_choice() = IsaChoice{isa, true};
+}
+
+// e.g. "avx2 (detected)" or "sse42 (forced, detected avx512)", for the logs
+inline std::string isa_report()
+{
+    const IsaChoice &c = isa_choice();
+    std::string res = isa_name(c.isa);
+    if (c.forced)
+        return res + " (forced, detected " + isa_name(detected_isa()) + ")";
+    return res + " (detected)";
+}
+
+/*----------------------------------------*/
+/*                 packs                  */
+/*----------------------------------------*/
+
+struct Scalar
+{
+    typedef double V;
+    static const int width = 1;
+    static V load(const double *p) { return *p; }
+    static void store(double *p, V v) { *p = v; }
+    static V set1(double a) { return a; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V abs(V a) { return std::fabs(a); }
+
+    typedef bool M;
+    static M le(V a, V b) { return a <= b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+namespace scalar
+{
+typedef Scalar P;
+typedef double V;
+typedef bool M;
+
+inline double sin(double x) { return std::sin(x); }
+inline double cos(double x) { return std::cos(x); }
+inline double exp(double x) { return std::exp(x); }
+inline double log(double x) { return std::log(x); }
+inline double pow(double x, double p) { return std::pow(x, p); }
+
+inline void apply(MathFunction fn, int nb, const double *x, double *y, double p)
+{
+    for (int k = 0; k < nb; ++k)
+    {
+        switch (fn)
+        {
+        case SIN:
+            y[k] = sin(x[k]);
+            break;
+        case COS:
+            y[k] = cos(x[k]);
+            break;
+        case EXP:
+            y[k] = exp(x[k]);
+            break;
+        case LOG:
+            y[k] = log(x[k]);
+            break;
+        default:
+            y[k] = pow(x[k], p);
+        }
+    }
+}
+} // namespace scalar
+
+#ifdef BBPROBLEMS_X86
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+struct Sse42
+{
+    typedef __m128d V;
+    typedef __m128d M;
+    static const int width = 2;
+
+    static V load(const double *p) { return _mm_loadu_pd(p); }
+    static void store(double *p, V v) { _mm_storeu_pd(p, v); }
+    static V set1(double a) { return _mm_set1_pd(a); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    // no FMA: two roundings
+    static V fmadd(V a, V b, V c) { return a * b + c; }
+    static V fnmadd(V a, V b, V c) { return c - a * b; }
+
+    // a b - ab exactly, for ab = a b rounded (Dekker's product)
+    static V mul_error(V a, V b, V ab)
+    {
+        const double SPLIT = 134217729.0; // 2^27 + 1
+        V ca = SPLIT * a, cb = SPLIT * b;
+        V ah = ca - (ca - a), bh = cb - (cb - b);
+        V al = a - ah, bl = b - bh;
+        return ((ah * bh - ab) + ah * bl + al * bh) + al * bl;
+    }
+
+    static M lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static M le(V a, V b) { return _mm_cmple_pd(a, b); }
+    static M gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static M eq(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    static M isnan(V a) { return _mm_cmpunord_pd(a, a); }
+    static bool any(M m) { return _mm_movemask_pd(m) != 0; }
+    static V select(M m, V a, V b) { return _mm_blendv_pd(b, a, m); }
+
+    // lanes where the given bit of the representation of a is set
+    static M bit(V a, int64_t b)
+    {
+        __m128i mask = _mm_set1_epi64x(b);
+        __m128i t = _mm_and_si128(_mm_castpd_si128(a), mask);
+        return _mm_castsi128_pd(_mm_cmpeq_epi64(t, mask));
+    }
+
+    // 2^k, from t = k + 0x1.8p52 (k integer, -1022 <= k <= 1023)
+    static V pow2(V t)
+    {
+        __m128i k = _mm_add_epi64(_mm_castpd_si128(t), _mm_set1_epi64x(1023 - 0x4338000000000000LL));
+        return _mm_castsi128_pd(_mm_slli_epi64(k, 52));
+    }
+
+    // biased exponent e (as a double) and mantissa m in [1, 2) of a > 0
+    static void split(V a, V &e, V &m)
+    {
+        __m128i bits = _mm_castpd_si128(a);
+        __m128i eb = _mm_or_si128(_mm_srli_epi64(bits, 52), _mm_set1_epi64x(0x4330000000000000LL));
+        e = _mm_sub_pd(_mm_castsi128_pd(eb), _mm_set1_pd(0x1.0p52));
+        __m128i mb = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x000fffffffffffffLL)),
+                                  _mm_set1_epi64x(0x3ff0000000000000LL));
+        m = _mm_castsi128_pd(mb);
+    }
+};
+
+namespace sse42
+{
+typedef Sse42 P;
+#include "simd_math.inc"
+} // namespace sse42
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+struct Avx2
+{
+    typedef __m256d V;
+    typedef __m256d M;
+    static const int width = 4;
+
+    static V load(const double *p) { return _mm256_loadu_pd(p); }
+    static void store(double *p, V v) { _mm256_storeu_pd(p, v); }
+    static V set1(double a) { return _mm256_set1_pd(a); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }   // a b + c
+    static V fnmadd(V a, V b, V c) { return _mm256_fnmadd_pd(a, b, c); } // c - a b
+    static V mul_error(V a, V b, V ab) { return _mm256_fmsub_pd(a, b, ab); }
+
+    static M lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static M le(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static M gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static M eq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static M isnan(V a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+    static bool any(M m) { return _mm256_movemask_pd(m) != 0; }
+    static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+
+    static M bit(V a, int64_t b)
+    {
+        __m256i mask = _mm256_set1_epi64x(b);
+        __m256i t = _mm256_and_si256(_mm256_castpd_si256(a), mask);
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(t, mask));
+    }
+
+    static V pow2(V t)
+    {
+        __m256i k = _mm256_add_epi64(_mm256_castpd_si256(t), _mm256_set1_epi64x(1023 - 0x4338000000000000LL));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(k, 52));
+    }
+
+    static void split(V a, V &e, V &m)
+    {
+        __m256i bits = _mm256_castpd_si256(a);
+        __m256i eb = _mm256_or_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x4330000000000000LL));
+        e = _mm256_sub_pd(_mm256_castsi256_pd(eb), _mm256_set1_pd(0x1.0p52));
+        __m256i mb = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffLL)),
+                                     _mm256_set1_epi64x(0x3ff0000000000000LL));
+        m = _mm256_castsi256_pd(mb);
+    }
+};
+
+namespace avx2
+{
+typedef Avx2 P;
+#include "simd_math.inc"
+} // namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+struct Avx512
+{
+    typedef __m512d V;
+    typedef __mmask8 M;
+    static const int width = 8;
+
+    static V load(const double *p) { return _mm512_loadu_pd(p); }
+    static void store(double *p, V v) { _mm512_storeu_pd(p, v); }
+    static V set1(double a) { return _mm512_set1_pd(a); }
+    // masked forms with all lanes: the unmasked ones pass an undefined
+    // source that GCC 12 reports as uninitialized
+    static V sqrt(V a) { return _mm512_mask_sqrt_pd(a, 0xff, a); }
+    static V abs(V a) { return _mm512_abs_pd(a); }
+    static V min(V a, V b) { return _mm512_mask_min_pd(a, 0xff, a, b); }
+    static V max(V a, V b) { return _mm512_mask_max_pd(a, 0xff, a, b); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V fnmadd(V a, V b, V c) { return _mm512_fnmadd_pd(a, b, c); }
+    static V mul_error(V a, V b, V ab) { return _mm512_fmsub_pd(a, b, ab); }
+
+    static M lt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static M le(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static M gt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static M eq(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static M isnan(V a) { return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+    static bool any(M m) { return m != 0; }
+    static V select(M m, V a, V b) { return _mm512_mask_blend_pd(m, b, a); }
+
+    static M bit(V a, int64_t b)
+    {
+        return _mm512_test_epi64_mask(_mm512_castpd_si512(a), _mm512_set1_epi64(b));
+    }
+
+    static V pow2(V t)
+    {
+        __m512i k = _mm512_add_epi64(_mm512_castpd_si512(t), _mm512_set1_epi64(1023 - 0x4338000000000000LL));
+        return _mm512_castsi512_pd(_mm512_mask_slli_epi64(k, 0xff, k, 52));
+    }
+
+    static void split(V a, V &e, V &m)
+    {
+        __m512i bits = _mm512_castpd_si512(a);
+        __m512i eb = _mm512_or_si512(_mm512_mask_srli_epi64(bits, 0xff, bits, 52), _mm512_set1_epi64(0x4330000000000000LL));
+        e = _mm512_sub_pd(_mm512_castsi512_pd(eb), _mm512_set1_pd(0x1.0p52));
+        __m512i mb = _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x000fffffffffffffLL)),
+                                     _mm512_set1_epi64(0x3ff0000000000000LL));
+        m = _mm512_castsi512_pd(mb);
+    }
+};
+
+namespace avx512
+{
+typedef Avx512 P;
+#include "simd_math.inc"
+} // namespace avx512
+#pragma GCC pop_options
+
+#endif
+
+/*----------------------------------------*/
+/*               dispatch                 */
+/*----------------------------------------*/
+
+// y[k] = fn(x[k]) (or pow(x[k], p)) for k < nb, with the kernels of isa
+inline void apply(MathFunction fn, int nb, const double *x, double *y, double p = 0, Isa isa = active_isa())
+{
+    switch (isa)
+    {
+#ifdef BBPROBLEMS_X86
+    case ISA_AVX512:
+        avx512::apply(fn, nb, x, y, p);
+        break;
+    case ISA_AVX2:
+        avx2::apply(fn, nb, x, y, p);
+        break;
+    case ISA_SSE42:
+        sse42::apply(fn, nb, x, y, p);
+        break;
+#endif
+    default:
+        scalar::apply(fn, nb, x, y, p);
+    }
+}
+
+} // namespace simd
+} // namespace bbproblems
+
+#endif
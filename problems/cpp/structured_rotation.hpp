@@ -0,0 +1,157 @@
+#ifndef STRUCTURED_ROTATION_HPP
+#define STRUCTURED_ROTATION_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*-----------------------------------------------------------------*/
+/*     Seeded orthogonal rotations in O(n log n) (Givens butterfly) */
+/*-----------------------------------------------------------------*/
+//
+// Q = S B_L ... B_1 P, with
+//  - P a random permutation of the coordinates;
+//  - B_l a layer of Givens rotations on the pairs (i, i + s) such that
+//    i mod 2s < s and i + s < n, of stride s = 2^((l - 1) mod d) with
+//    d = ceil(log2 n), each with its own random angle. L = 2d layers: two
+//    passes over the strides, so that each y_i mixes all the x_j;
+//  - S a diagonal of random signs.
+// Q is orthogonal by construction and y = Q x costs at most 6 n d flops,
+// against 2 n^2 for a dense matrix.
+//
+// The random numbers are those of splitmix64 from the seed, so that other
+// languages can rebuild Q. They are drawn in this order: the permutation
+// (Fisher-Yates, for i = n - 1 down to 1, j = floor(u (i + 1))), the
+// angles 2 pi u of the layers in order and of their pairs by increasing i,
+// then the signs (u < 0.5 gives -1), with u = (z >> 11) 2^-53 for the
+// 64-bit output z.
+
+namespace bbproblems
+{
+
+// splitmix64 (Steele, Lea and Flood, 2014): next 64-bit output of state
+inline uint64_t splitmix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// u in [0, 1) from the 53 high bits of the next output
+inline double splitmix_uniform(uint64_t &state)
+{
+    return static_cast<double>(splitmix64(state) >> 11) * 0x1.0p-53;
+}
+
+class StructuredRotation
+{
+    struct Layer
+    {
+        int stride;
+        std::vector<double> c, s; // cosine and sine of each pair
+    };
+
+    int n = 0;
+    std::vector<int> perm; // y_i = x_perm[i] before the layers
+    std::vector<Layer> layers;
+    std::vector<double> signs;
+
+public:
+    StructuredRotation() = default;
+
+    StructuredRotation(int dim, uint64_t seed) : n(dim), perm(dim), signs(dim)
+    {
+        uint64_t state = seed;
+        for (int i = 0; i < n; ++i)
+        {
+            perm[i] = i;
+        }
+        for (int i = n - 1; i > 0; --i)
+        {
+            int j = static_cast<int>(splitmix_uniform(state) * (i + 1));
+            std::swap(perm[i], perm[j]);
+        }
+
+        int depth = 0;
+        while ((1 << depth) < n)
+        {
+            ++depth;
+        }
+        const double TWO_PI = 6.283185307179586476925;
+        for (int l = 0; l < 2 * depth; ++l)
+        {
+            Layer layer;
+            layer.stride = 1 << (l % depth);
+            for (int i = 0; i + layer.stride < n; ++i)
+            {
+                if (i % (2 * layer.stride) < layer.stride)
+                {
+                    double angle = TWO_PI * splitmix_uniform(state);
+                    layer.c.push_back(std::cos(angle));
+                    layer.s.push_back(std::sin(angle));
+                }
+            }
+            layers.push_back(layer);
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            signs[i] = (splitmix_uniform(state) < 0.5) ? -1 : 1;
+        }
+    }
+
+    int size() const
+    {
+        return n;
+    }
+
+    // y = Q x (y and x distinct)
+    void apply(const double *x, double *y) const
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            y[i] = x[perm[i]];
+        }
+        for (const Layer &layer : layers)
+        {
+            int s = layer.stride;
+            size_t p = 0;
+            for (int b = 0; b < n; b += 2 * s)
+            {
+                for (int i = b; i < b + s && i + s < n; ++i, ++p)
+                {
+                    double a = y[i], c = y[i + s];
+                    y[i] = layer.c[p] * a - layer.s[p] * c;
+                    y[i + s] = layer.s[p] * a + layer.c[p] * c;
+                }
+            }
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            y[i] *= signs[i];
+        }
+    }
+
+    // Q as a dense row-major matrix, Q[i * n + j] (for checks)
+    std::vector<double> dense() const
+    {
+        std::vector<double> q(static_cast<size_t>(n) * n), e(n), col(n);
+        for (int j = 0; j < n; ++j)
+        {
+            e[j] = 1;
+            apply(e.data(), col.data());
+            e[j] = 0;
+            for (int i = 0; i < n; ++i)
+            {
+                q[static_cast<size_t>(i) * n + j] = col[i];
+            }
+        }
+        return q;
+    }
+};
+
+} // namespace bbproblems
+
+#endif
@@ -17,6 +17,8 @@
 # x <= 1.0
 # x >= 0.0
 #
+isdefined(@__MODULE__, :cached_rotation) || include(joinpath(@__DIR__, "load_rotation.jl"))
+
 function L2ZDT4(x)
 
     #params 
@@ -52,6 +54,7 @@ function L2ZDT4(x)
           0.0417966   -0.687391    0.438773    0.287357    0.316636   -0.262311   -0.0755541  -0.442313     0.621378    0.670105    0.060982     0.944162    0.643442   -0.750684  -0.639973    0.217424    0.592823    0.929094    -0.239135   -0.41628     0.570893  -0.0798988  -0.917135   -0.749545    -0.982047    0.0626998  -0.977963    0.660401    0.470569    -0.0528868;
          -0.00138645   0.931065   -0.748519    0.304188   -0.266153    0.672524   -0.105179   -0.874749    -0.154355   -0.774656   -0.69654      0.433098    0.615897   -0.387919  -0.429779    0.650202    0.122306   -0.237727     0.626817   -0.227929    0.405916   0.483328    0.282047   -0.262206     0.784123    0.83125    -0.662272    0.702768    0.875814    -0.701221;
           0.553793     0.471795    0.769147    0.059668   -0.841617   -0.191179   -0.972471   -0.825361     0.779826   -0.917201    0.43272      0.10301     0.358771    0.793448  -0.0379954  -0.870112    0.600442   -0.990603     0.549151    0.512146   -0.795843   0.490091    0.372046   -0.549437     0.0964285   0.753047   -0.86284    -0.589688    0.178612    -0.720358]
+    M = cached_rotation("M30", M)
 
     # functions
     y = M * x;
@@ -17,6 +17,8 @@
 # x <= 1.0
 # x >= 0.0
 #
+isdefined(@__MODULE__, :cached_rotation) || include(joinpath(@__DIR__, "load_rotation.jl"))
+
 function L3ZDT6(x)
 
     #params 
@@ -32,6 +34,7 @@ function L3ZDT6(x)
          -0.207987	-0.865931	 0.613732   -0.525712	-0.995728	0.389633	-0.064173	 0.662131	-0.707048	-0.340423;
          0.60624	  0.0951648   -0.160446   -0.394585	-0.167581	0.0679849 0.449799	 0.733505	-0.00918638	0.00446808;
          0.404396	 0.449996	 0.162711	0.294454	-0.563345   -0.114993	0.549589	-0.775141	0.677726	0.610715];
+    M = cached_rotation("A10", M)
 
     # functions
     y = M * x.^2;
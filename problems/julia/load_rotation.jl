@@ -0,0 +1,72 @@
+# Matrix of the rotation cache written by scripts/analytical/rotation_cache
+# (format and generators in problems/cpp/rotation_cache.hpp), shared with
+# the C++ tools and the MATLAB loader.
+#
+#   A = load_rotation("rotations.bin", "A10")   # same values as DPAM1.jl
+#
+# The file is memory-mapped; the matrices are stored row-major, the result
+# is a Julia (column-major) copy. The FNV-1a hash of the matrix bytes is
+# checked against the one of its entry.
+#
+# cached_rotation(name, literal) is what the problems use: the matrix name
+# of the file named by ENV["BBPROBLEMS_ROTATION_CACHE"], loaded once per
+# process, or literal without the variable, or if the matrix is absent, of
+# another size or altered (then reported once), as rotation_A10()... of
+# rotation_cache.hpp.
+#
+using Mmap
+
+function load_rotation(path::AbstractString, name::AbstractString)
+    open(path, "r") do io
+        bytes = Mmap.mmap(io, Vector{UInt8}, filesize(io))
+        u32(k) = Int(ltoh(reinterpret(UInt32, bytes[k+1:k+4])[1]))
+        u64(k) = ltoh(reinterpret(UInt64, bytes[k+1:k+8])[1])
+
+        if length(bytes) < 16 || String(bytes[1:8]) != "BBROTMAT" || u32(8) != 1
+            error("$path: not a rotation cache (version 1)")
+        end
+        for k in 0:u32(12)-1
+            e = 16 + 64 * k
+            raw = bytes[e+1:e+40]
+            len = something(findfirst(==(0x00), raw), 41) - 1
+            if String(raw[1:len]) == name
+                rows = u32(e + 40)
+                cols = u32(e + 44)
+                offset = Int(u64(e + 48))
+                data = view(bytes, offset+1:offset+8*rows*cols)
+                h = 0xcbf29ce484222325
+                for b in data
+                    h = (h ⊻ b) * 0x00000100000001b3
+                end
+                if h != u64(e + 56)
+                    error("$path: matrix $name altered (FNV-1a hash)")
+                end
+                values = ltoh.(reinterpret(Float64, data))
+                return permutedims(reshape(values, cols, rows))
+            end
+        end
+        error("$path: no matrix $name")
+    end
+end
+
+const CACHED_ROTATIONS = Dict{String,Union{Matrix{Float64},Nothing}}()
+
+function cached_rotation(name::AbstractString, literal::Matrix{Float64})
+    path = get(ENV, "BBPROBLEMS_ROTATION_CACHE", "")
+    if isempty(path)
+        return literal
+    end
+    A = get!(CACHED_ROTATIONS, name) do
+        try
+            M = load_rotation(path, name)
+            if size(M) != size(literal)
+                error("$path: matrix $name is $(size(M, 1)) x $(size(M, 2))")
+            end
+            M
+        catch e
+            @warn "no valid matrix $name in the rotation cache, the literal is used" exception = e
+            nothing
+        end
+    end
+    return A === nothing ? literal : A
+end
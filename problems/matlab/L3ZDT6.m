@@ -31,6 +31,7 @@ M = [0.218418	-0.620254	 0.843784	0.914311	-0.788548	0.428212 0.103064	-0.47373
 -0.207987	-0.865931	 0.613732   -0.525712	-0.995728	0.389633	-0.064173	 0.662131	-0.707048	-0.340423;
 0.60624	  0.0951648   -0.160446   -0.394585	-0.167581	0.0679849 0.449799	 0.733505	-0.00918638	0.00446808;
 0.404396	 0.449996	 0.162711	0.294454	-0.563345   -0.114993	0.549589	-0.775141	0.677726	0.610715];
+M = cached_rotation('A10', M);
 
 % functions
 y = M * x.^2;
@@ -0,0 +1,35 @@
+% Rotation matrix of the problems: the matrix name of the cache file named
+% by the environment variable BBPROBLEMS_ROTATION_CACHE, loaded once per
+% session (load_rotation), or literal without the variable, or if the
+% matrix is absent, of another size or altered (then reported once), as
+% rotation_A10()... of problems/cpp/rotation_cache.hpp.
+%
+%   M = cached_rotation('M30', M);
+%
+function [A] = cached_rotation(name, literal)
+    persistent loaded;
+    path = getenv('BBPROBLEMS_ROTATION_CACHE');
+    if isempty(path)
+        A = literal;
+        return;
+    end
+    if isempty(loaded)
+        loaded = containers.Map();
+    end
+    if ~isKey(loaded, name)
+        try
+            M = load_rotation(path, name);
+            if ~isequal(size(M), size(literal))
+                error('%s: matrix %s is %d x %d', path, name, size(M, 1), size(M, 2));
+            end
+            loaded(name) = M;
+        catch e
+            warning('no valid matrix %s in the rotation cache, the literal is used (%s)', name, e.message);
+            loaded(name) = [];
+        end
+    end
+    A = loaded(name);
+    if isempty(A)
+        A = literal;
+    end
+end
@@ -0,0 +1,57 @@
+% Matrix of the rotation cache written by scripts/analytical/rotation_cache
+% (format and generators in problems/cpp/rotation_cache.hpp), shared with
+% the C++ tools and the Julia loader.
+%
+%   A = load_rotation('rotations.bin', 'A10');   % same values as DPAM1.m
+%
+% The file is read through memmapfile; the matrices are stored row-major
+% (little-endian). The FNV-1a hash of the matrix bytes is checked against
+% the one of its entry; MATLAB integers saturate, so the hash is computed on
+% four 16-bit limbs held in doubles.
+%
+function [A] = load_rotation(path, name)
+    m = memmapfile(path, 'Format', 'uint8');
+    bytes = m.Data;
+    if numel(bytes) < 16 || ~strcmp(char(bytes(1:8)'), 'BBROTMAT') || ...
+            typecast(bytes(9:12), 'uint32') ~= 1
+        error('%s: not a rotation cache (version 1)', path);
+    end
+    count = double(typecast(bytes(13:16), 'uint32'));
+    for k = 0:count-1
+        e = 16 + 64 * k;
+        raw = bytes(e+1:e+40)';
+        if strcmp(char(raw(raw ~= 0)), name)
+            rows = double(typecast(bytes(e+41:e+44), 'uint32'));
+            cols = double(typecast(bytes(e+45:e+48), 'uint32'));
+            offset = double(typecast(bytes(e+49:e+56), 'uint64'));
+            stored = double(typecast(bytes(e+57:e+64), 'uint16'));
+            if ~isequal(fnv1a(bytes(offset+1:offset+8*rows*cols)), stored(:)')
+                error('%s: matrix %s altered (FNV-1a hash)', path, name);
+            end
+            v = memmapfile(path, 'Offset', offset, 'Format', {'double', [cols rows], 'M'}, 'Repeat', 1);
+            A = v.Data.M';
+            return;
+        end
+    end
+    error('%s: no matrix %s', path, name);
+end
+
+% FNV-1a hash of data (uint8), as its 16-bit limbs, least significant first
+function [h] = fnv1a(data)
+    h = [8997 33826 40164 52210]; % 0xcbf29ce484222325
+    p = [435 0 256 0];            % 0x100000001b3
+    for b = double(data(:))'
+        h(1) = bitxor(h(1), b);
+        r = zeros(1, 4);
+        for i = 1:4
+            for j = 1:5-i
+                r(i+j-1) = r(i+j-1) + h(i) * p(j);
+            end
+        end
+        for i = 1:3
+            r(i+1) = r(i+1) + floor(r(i) / 65536);
+            r(i) = mod(r(i), 65536);
+        end
+        h = [r(1:3) mod(r(4), 65536)];
+    end
+end
@@ -0,0 +1,62 @@
+#include <exception>
+#include "../../problems/cpp/problems.hpp"
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*      C interface of the problems of problems/cpp (ccall)        */
+/*-----------------------------------------------------------------*/
+//
+// Shared library through which the Julia harness of the analytical campaign
+// (analytical_problems.jl) evaluates the objectives with the C++ problems
+// instead of the MATLAB files: the problems of all_problems(), DTLZ1-6 and
+// WFG1-9 (by their names in problems/julia) and the scalable variants, as
+// written in problems/julia and problems/matlab (find_harness_problem: L2ZDT1
+// with the full digits of M30). No exception crosses the interface.
+//
+// Compile: g++ -O3 -std=c++17 -shared -fPIC bbproblems_lib.cpp -o libbbproblems.so
+//
+// Julia:
+//   lib = Libdl.dlopen("libbbproblems.so")
+//   pb = ccall(Libdl.dlsym(lib, :bbproblems_find), Ptr{Cvoid},
+//              (Cstring, Ref{Cint}, Ref{Cint}), "L2ZDT1", n, m)
+//   ccall(Libdl.dlsym(lib, :bbproblems_objectives), Cint,
+//         (Ptr{Cvoid}, Ptr{Cdouble}, Ptr{Cdouble}), pb, x, f)
+
+extern "C"
+{
+
+// problem of that name and its numbers of variables and objectives, or
+// NULL if it is unknown; the problem lives as long as the process
+const void *bbproblems_find(const char *name, int *n, int *m)
+{
+    try
+    {
+        const Problem *pb = find_harness_problem(name);
+        if (pb != nullptr)
+        {
+            *n = pb->n;
+            *m = pb->m;
+        }
+        return pb;
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+// f (m values) at x (n values); 1 on success, 0 otherwise
+int bbproblems_objectives(const void *problem, const double *x, double *f)
+{
+    try
+    {
+        static_cast<const Problem *>(problem)->objectives(x, f);
+        return 1;
+    }
+    catch (const std::exception &)
+    {
+        return 0;
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,181 @@
+#ifndef BIMADS_RUNNER_HPP
+#define BIMADS_RUNNER_HPP
+
+#include <list>
+#include <string>
+#include <vector>
+#include "nomad.hpp"
+#include "parallel_bimads.hpp"
+#include "../../problems/cpp/batch_constraints.hpp"
+#include "../../problems/cpp/batch_problems.hpp"
+#include "../../problems/cpp/problems.hpp"
+
+/*-----------------------------------------------------------------*/
+/*   BiMADS on any (problem, family) of problems/cpp (NOMAD 3)     */
+/*-----------------------------------------------------------------*/
+//
+// Same settings as the drivers of problems/bimads: the n starting points
+// x0_j = lb + j (ub - lb) / (n - 1), constraints treated with the
+// progressive barrier, models and Nelder-Mead search left to the defaults.
+// With BB_MAX_BLOCK_SIZE > 1, NOMAD evaluates blocks of points: they are
+// gathered in one PointBatch and evaluated by the batched kernels.
+
+class ProblemEvaluator : public NOMAD::Multi_Obj_Evaluator
+{
+    const bbproblems::Problem &pb;
+    int family;
+    int nc;
+    bbproblems::ConstraintKernels kernels;
+    mutable std::vector<double> x, f, c;
+    mutable bbproblems::PointBatch xb, fb, cb;
+
+public:
+    ProblemEvaluator(const NOMAD::Parameters &p, const bbproblems::Problem &problem, int fam)
+        : NOMAD::Multi_Obj_Evaluator(p), pb(problem), family(fam),
+          nc(bbproblems::nb_constraints(fam, problem.n)), kernels(bbproblems::constraint_kernels(fam)),
+          x(problem.n), f(problem.m), c(nc), xb(problem.n, 0)
+    {
+    }
+
+    ~ProblemEvaluator(void) {}
+
+    bool eval_x(NOMAD::Eval_Point &point,
+                const NOMAD::Double & /*h_max*/,
+                bool &count_eval) const
+    {
+        for (int i = 0; i < pb.n; ++i)
+        {
+            x[i] = point[i].value();
+        }
+        pb.objectives(x.data(), f.data());
+        kernels.point(pb.n, x.data(), c.data());
+
+        for (int j = 0; j < pb.m; ++j)
+        {
+            point.set_bb_output(j, f[j]); // objectives
+        }
+        for (int j = 0; j < nc; ++j)
+        {
+            point.set_bb_output(pb.m + j, c[j]); // constraints
+        }
+
+        count_eval = true; // count a black-box evaluation
+
+        return true; // the evaluation succeeded
+    }
+
+    bool eval_x(std::list<NOMAD::Eval_Point *> &list_x,
+                const NOMAD::Double & /*h_max*/,
+                std::list<bool> &list_count_eval) const
+    {
+        xb.gather(list_x.begin(), list_x.end(),
+                  [](const NOMAD::Eval_Point *point, int i) { return (*point)[i].value(); });
+        bbproblems::eval_objectives_batch(pb, xb, fb);
+        bbproblems::eval_constraints_batch(family, xb, cb);
+
+        fb.scatter(list_x.begin(), list_x.end(),
+                   [](NOMAD::Eval_Point *point, int j, double v) { point->set_bb_output(j, v); }); // objectives
+        cb.scatter(list_x.begin(), list_x.end(),
+                   [this](NOMAD::Eval_Point *point, int j, double v) { point->set_bb_output(pb.m + j, v); }); // constraints
+
+        list_count_eval.assign(list_x.size(), true); // count the black-box evaluations
+
+        return true; // the evaluations succeeded
+    }
+};
+
+// (problem, family) as a blackbox of parallel_bimads.hpp
+inline BlackBox problem_blackbox(const bbproblems::Problem &pb, int family)
+{
+    BlackBox bb;
+    bb.n = pb.n;
+    bb.m = pb.m;
+    bb.nc = bbproblems::nb_constraints(family, pb.n);
+    bb.lb = pb.lb;
+    bb.ub = pb.ub;
+    bb.x0 = bbproblems::starting_points(pb);
+    bbproblems::ConstraintKernels kernels = bbproblems::constraint_kernels(family);
+    bb.eval = [&pb, kernels](const double *x, double *out)
+    {
+        pb.objectives(x, out);
+        kernels.point(pb.n, x, out + pb.m);
+    };
+    return bb;
+}
+
+// Runs BiMADS and writes its history in history_file. Returns EXIT_SUCCESS
+// or EXIT_FAILURE, like the drivers.
+inline int run_bimads(int argc, char **argv, const bbproblems::Problem &pb, int family,
+                      int seed, int budget, const std::string &history_file)
+{
+    NOMAD::Display out(std::cout);
+    out.precision(NOMAD::DISPLAY_PRECISION_STD);
+    int status = EXIT_SUCCESS;
+
+    try
+    {
+        NOMAD::begin(argc, argv);
+
+        NOMAD::Parameters p(out);
+
+        int n = pb.n;
+        int m = pb.m;
+        int l = bbproblems::nb_constraints(family, n);
+
+        p.set_DIMENSION(n);
+
+        std::vector<NOMAD::bb_output_type> bbot(m + l);
+        for (int i = 0; i < m; ++i)
+        {
+            bbot[i] = NOMAD::OBJ;
+        }
+        for (int i = m; i < m + l; ++i)
+        {
+            bbot[i] = NOMAD::PB;
+        }
+        p.set_BB_OUTPUT_TYPE(bbot);
+
+        NOMAD::Point lb(n), ub(n);
+        for (int i = 0; i < n; ++i)
+        {
+            lb[i] = pb.lb[i];
+            ub[i] = pb.ub[i];
+        }
+        p.set_LOWER_BOUND(lb);
+        p.set_UPPER_BOUND(ub);
+
+        for (const std::vector<double> &x0s : bbproblems::starting_points(pb))
+        {
+            NOMAD::Point x0(n);
+            for (int i = 0; i < n; ++i)
+            {
+                x0[i] = x0s[i];
+            }
+            p.set_X0(x0);
+        }
+
+        p.set_DISPLAY_STATS("obj");
+        p.set_MULTI_OVERALL_BB_EVAL(budget);
+        p.set_SEED(seed);
+        p.set_HISTORY_FILE(history_file);
+
+        p.check();
+
+        ProblemEvaluator ev(p, pb, family);
+
+        NOMAD::Mads mads(p, &ev);
+        mads.multi_run();
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+        status = EXIT_FAILURE;
+    }
+
+    NOMAD::Slave::stop_slaves(out);
+    NOMAD::end();
+
+    return status;
+}
+
+#endif
@@ -0,0 +1,275 @@
+#ifndef BIMADS_SUBPROBLEMS_HPP
+#define BIMADS_SUBPROBLEMS_HPP
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+#include "run_files.hpp"
+
+/*-----------------------------------------------------------------*/
+/*        Single-objective subproblems of BiMADS (no NOMAD)        */
+/*-----------------------------------------------------------------*/
+//
+// BiMADS (Audet, Savard, Zghal, 2008) first minimizes each objective alone
+// (the two anchors), then solves a sequence of single-objective subproblems:
+// each one picks the point of the current front with the largest gaps to its
+// neighbours and minimizes the distance to the reference point built from
+// these neighbours. Same rules as Mads::multi_run of NOMAD 3:
+//  - gap of the j-th point of the front (sorted by f1):
+//      |F_{j-1} - F_j|^2 + |F_j - F_{j+1}|^2, or 2 |F_j - F_neighbour|^2 at
+//    the ends, divided by 1 + the number of times the point was chosen;
+//  - reference point r = (f1(x_{j+1}), f2(x_{j-1}));
+//  - objective phi_r(f) = -(r1 - f1)^2 (r2 - f2)^2 if f dominates r, and
+//    the squared distance from f to the set dominating r otherwise.
+
+// one feasible nondominated point
+struct FrontPoint
+{
+    std::vector<double> x;
+    double f1;
+    double f2;
+};
+
+struct Subproblem
+{
+    int anchor = -1; // objective minimized alone, or -1 for a reference point
+    double r1 = 0;
+    double r2 = 0;
+    double p1 = 0; // objectives of the chosen point of the front
+    double p2 = 0;
+    int max_bb_eval = 0; // 0: the default budget of a subproblem
+    std::vector<std::vector<double>> x0; // starting points
+};
+
+// score of the j-th point of a front: the larger, the sooner it is chosen
+typedef std::function<double(const std::vector<FrontPoint> &, size_t)> GapScore;
+
+// feasible nondominated points of evals, sorted by increasing f1
+inline std::vector<FrontPoint> pareto_front(const std::vector<RunEval> &evals)
+{
+    std::vector<const RunEval *> feasible;
+    for (const RunEval &e : evals)
+    {
+        if (e.f.size() >= 2 && e.is_feasible())
+            feasible.push_back(&e);
+    }
+    std::sort(feasible.begin(), feasible.end(), [](const RunEval *a, const RunEval *b)
+              { return a->f[0] < b->f[0] || (a->f[0] == b->f[0] && a->f[1] < b->f[1]); });
+
+    std::vector<FrontPoint> front;
+    for (const RunEval *e : feasible)
+    {
+        if (front.empty() || e->f[1] < front.back().f2)
+            front.push_back(FrontPoint{e->x, e->f[0], e->f[1]});
+    }
+    return front;
+}
+
+inline double bimads_objective(const Subproblem &sp, double f1, double f2)
+{
+    if (sp.anchor == 0)
+        return f1;
+    if (sp.anchor == 1)
+        return f2;
+    if (f1 <= sp.r1 && f2 <= sp.r2)
+        return -(sp.r1 - f1) * (sp.r1 - f1) * (sp.r2 - f2) * (sp.r2 - f2);
+    double a = std::max(0.0, f1 - sp.r1);
+    double b = std::max(0.0, f2 - sp.r2);
+    return a * a + b * b;
+}
+
+// Chooses the reference points, remembering how many times each point of the
+// front was chosen. A point chosen for a running subproblem already counts,
+// so concurrent subproblems spread over different gaps.
+class ReferencePointSelector
+{
+    std::map<std::pair<double, double>, int> chosen;
+
+    static double dist2(const FrontPoint &a, const FrontPoint &b)
+    {
+        return (a.f1 - b.f1) * (a.f1 - b.f1) + (a.f2 - b.f2) * (a.f2 - b.f2);
+    }
+
+public:
+    // gap of NOMAD: squared distances of the j-th point to its neighbours
+    static double distance_gap(const std::vector<FrontPoint> &front, size_t j)
+    {
+        size_t p = front.size();
+        if (p < 2)
+            return 0;
+        if (j == 0)
+            return 2 * dist2(front[0], front[1]);
+        if (j == p - 1)
+            return 2 * dist2(front[p - 2], front[p - 1]);
+        return dist2(front[j - 1], front[j]) + dist2(front[j], front[j + 1]);
+    }
+
+    // false if the front is empty; index (if given) receives the position of
+    // the chosen point in the front
+    bool next(const std::vector<FrontPoint> &front, Subproblem &sp, const GapScore &score = nullptr,
+              size_t *index = nullptr)
+    {
+        if (front.empty())
+            return false;
+        size_t p = front.size();
+        size_t best = 0;
+        double best_gap = -1;
+        for (size_t j = 0; j < p; ++j)
+        {
+            double gap = score ? score(front, j) : distance_gap(front, j);
+            auto it = chosen.find(std::make_pair(front[j].f1, front[j].f2));
+            gap /= 1 + (it == chosen.end() ? 0 : it->second);
+            if (gap > best_gap)
+            {
+                best_gap = gap;
+                best = j;
+            }
+        }
+        ++chosen[std::make_pair(front[best].f1, front[best].f2)];
+
+        const FrontPoint &prev = front[best > 0 ? best - 1 : best];
+        const FrontPoint &next = front[best + 1 < p ? best + 1 : best];
+        sp.anchor = -1;
+        sp.r1 = next.f1;
+        sp.r2 = prev.f2;
+        sp.p1 = front[best].f1;
+        sp.p2 = front[best].f2;
+        sp.x0.assign(1, front[best].x);
+        if (index != nullptr)
+            *index = best;
+        return true;
+    }
+
+    // the point of sp counts as chosen times more
+    void penalize(const Subproblem &sp, int times)
+    {
+        chosen[std::make_pair(sp.p1, sp.p2)] += times;
+    }
+};
+
+// Budget of each subproblem from the hypervolume it can still add.
+//
+// Objectives are scaled to [0, 1] by the extremes of the front found by the
+// anchors, with the reference point (1.1, 1.1). The gap of the j-th point is
+// the area that its subproblem can add: the box between its neighbours,
+// minus what the point already dominates. A subproblem gets a share of the
+// remaining evaluations proportional to the area of its gap among all the
+// gaps, between 1/4 and 4 times the fixed budget / nb_runs. A subproblem
+// whose hypervolume gain per evaluation is under a tenth of the mean so far
+// is unproductive: its gap is then chosen less often.
+class AdaptiveBudget
+{
+    int base;
+    bool bounded = false;
+    double ideal1 = 0, ideal2 = 0, range1 = 1, range2 = 1;
+    double total_gain = 0;
+    long total_evals = 0;
+
+    double s1(double f1) const
+    {
+        return (f1 - ideal1) / range1;
+    }
+    double s2(double f2) const
+    {
+        return (f2 - ideal2) / range2;
+    }
+
+public:
+    AdaptiveBudget(long total_budget, int nb_runs)
+        : base(static_cast<int>(std::max(1L, total_budget / std::max(1, nb_runs))))
+    {
+    }
+
+    bool ready() const
+    {
+        return bounded;
+    }
+
+    // fixes the scaling with the extremes of front (after the anchors)
+    void set_bounds(const std::vector<FrontPoint> &front)
+    {
+        if (front.empty())
+            return;
+        ideal1 = front.front().f1;
+        ideal2 = front.back().f2;
+        range1 = front.back().f1 - ideal1;
+        range2 = front.front().f2 - ideal2;
+        if (!(range1 > 0))
+            range1 = 1;
+        if (!(range2 > 0))
+            range2 = 1;
+        bounded = true;
+    }
+
+    // scaled hypervolume of front (sorted by increasing f1)
+    double hypervolume(const std::vector<FrontPoint> &front) const
+    {
+        const double ref = 1.1;
+        double hv = 0, last2 = ref;
+        for (const FrontPoint &p : front)
+        {
+            double a = s1(p.f1), b = s2(p.f2);
+            if (a >= ref || b >= last2)
+                continue;
+            hv += (ref - a) * (last2 - b);
+            last2 = b;
+        }
+        return hv;
+    }
+
+    // scaled area that a subproblem on the j-th point can add
+    double gap_area(const std::vector<FrontPoint> &front, size_t j) const
+    {
+        size_t p = front.size();
+        const FrontPoint &prev = front[j > 0 ? j - 1 : j];
+        const FrontPoint &next = front[j + 1 < p ? j + 1 : j];
+        double box = (s1(next.f1) - s1(prev.f1)) * (s2(prev.f2) - s2(next.f2));
+        double dominated = (s1(next.f1) - s1(front[j].f1)) * (s2(prev.f2) - s2(front[j].f2));
+        return std::max(0.0, box - dominated);
+    }
+
+    // evaluations given to a subproblem on the j-th point
+    int run_budget(const std::vector<FrontPoint> &front, size_t j, long remaining) const
+    {
+        double total = 0;
+        for (size_t k = 0; k < front.size(); ++k)
+            total += gap_area(front, k);
+        long b = base;
+        if (total > 0)
+            b = static_cast<long>(remaining * gap_area(front, j) / total);
+        b = std::max(static_cast<long>(base / 4), std::min(b, 4L * base));
+        return static_cast<int>(std::max(1L, std::min(b, remaining)));
+    }
+
+    // records the gain of a finished subproblem; true if it was unproductive
+    bool record(double gain, long evals)
+    {
+        if (evals <= 0)
+            return false;
+        double mean = (total_evals > 0) ? total_gain / total_evals : 0;
+        total_gain += std::max(0.0, gain);
+        total_evals += evals;
+        return mean > 0 && gain / evals < 0.1 * mean;
+    }
+};
+
+// Budgets of the subproblems of a round of the deterministic parallel
+// BiMADS, in launch order: each gets what it requested, as long as the
+// remaining evaluations last; the subproblems left with nothing are dropped.
+inline std::vector<int> split_round_budget(const std::vector<int> &requested, long remaining)
+{
+    std::vector<int> budgets;
+    for (int r : requested)
+    {
+        int b = static_cast<int>(std::min(static_cast<long>(std::max(1, r)), remaining));
+        if (b <= 0)
+            break;
+        budgets.push_back(b);
+        remaining -= b;
+    }
+    return budgets;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "shared_eval_cache.hpp"
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*        Contention benchmark of the shared evaluation cache      */
+/*-----------------------------------------------------------------*/
+//
+// Each thread runs the same mix of operations as a solver with a cache:
+// look a point up, and insert it when it is missing. A fraction of the
+// lookups hit points inserted beforehand (spread over all the shards), the
+// others are new points. The throughput is measured for 1, 2, 4, ..., up to
+// the given number of threads, for each number of shards (1 shard is a
+// single lock), with exact keys or with a tolerance.
+//
+// Compile: g++ -O3 -std=c++17 -pthread cache_benchmark.cpp -o cache_benchmark
+//
+// Usage: cache_benchmark [-n dimension] [-t max_threads] [-o operations] [-r hit_ratio]
+//                        [-s shards] [-e tolerance]
+//   -n : number of inputs (default 30), 2 outputs per point
+//   -t : largest number of threads (default 64)
+//   -o : operations per thread (default 20000)
+//   -r : fraction of lookups of known points (default 0.5)
+//   -s : comma-separated numbers of shards (default 1,64)
+//   -e : tolerance of the lookups (default 0: exact)
+//   Prints one line per (shards, threads): total operations per second and
+//   speedup over one thread.
+
+static vector<int> split_ints(const string &s)
+{
+    vector<int> res;
+    size_t start = 0;
+    while (start < s.size())
+    {
+        size_t end = s.find(',', start);
+        if (end == string::npos)
+            end = s.size();
+        if (end > start)
+            res.push_back(atoi(s.substr(start, end - start).c_str()));
+        start = end + 1;
+    }
+    return res;
+}
+
+static void usage()
+{
+    cerr << "Usage: cache_benchmark [-n dimension] [-t max_threads] [-o operations] [-r hit_ratio]\n"
+            "                       [-s shards] [-e tolerance]\n";
+    exit(EXIT_FAILURE);
+}
+
+// operations per second of nthreads threads on a fresh cache
+static double measure(int n, int nshards, double tolerance, int nthreads, long operations, double hit_ratio)
+{
+    const long KNOWN = 4096;
+    long capacity = KNOWN + static_cast<long>(nthreads * operations * (1 - hit_ratio)) + 1;
+    SharedEvalCache cache(n, 2, capacity, capacity, tolerance, nshards);
+
+    mt19937_64 gen(1234);
+    uniform_real_distribution<double> unif(0, 1);
+    vector<double> known(KNOWN * n);
+    vector<double> out = {1, 2};
+    for (long k = 0; k < KNOWN; ++k)
+    {
+        for (int i = 0; i < n; ++i)
+            known[k * n + i] = unif(gen);
+        cache.insert(&known[k * n], out.data());
+    }
+
+    atomic<int> ready(0);
+    atomic<bool> go(false);
+    vector<thread> threads;
+    for (int t = 0; t < nthreads; ++t)
+    {
+        threads.emplace_back([&, t]()
+                             {
+            mt19937_64 g(t + 1);
+            uniform_real_distribution<double> u(0, 1);
+            vector<double> x(n), f(2);
+            ++ready;
+            while (!go)
+                this_thread::yield();
+            for (long k = 0; k < operations; ++k)
+            {
+                if (u(g) < hit_ratio)
+                {
+                    long j = static_cast<long>(u(g) * KNOWN);
+                    cache.find(&known[j * n], f.data());
+                }
+                else
+                {
+                    for (int i = 0; i < n; ++i)
+                        x[i] = u(g);
+                    if (!cache.find(x.data(), f.data()))
+                        cache.insert(x.data(), out.data());
+                }
+            } });
+    }
+    while (ready < nthreads)
+        this_thread::yield();
+    auto start = chrono::steady_clock::now();
+    go = true;
+    for (thread &th : threads)
+        th.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return nthreads * operations / seconds;
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    int n = 30, max_threads = 64;
+    long operations = 20000;
+    double hit_ratio = 0.5, tolerance = 0;
+    string shards = "1,64";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc)
+            n = max(1, atoi(argv[++i]));
+        else if (arg == "-t" && i + 1 < argc)
+            max_threads = max(1, atoi(argv[++i]));
+        else if (arg == "-o" && i + 1 < argc)
+            operations = max(1L, atol(argv[++i]));
+        else if (arg == "-r" && i + 1 < argc)
+            hit_ratio = atof(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc)
+            shards = argv[++i];
+        else if (arg == "-e" && i + 1 < argc)
+            tolerance = atof(argv[++i]);
+        else
+            usage();
+    }
+
+    try
+    {
+        cout << "hardware threads: " << thread::hardware_concurrency() << ", n = " << n
+             << ", tolerance = " << tolerance << ", hit ratio = " << hit_ratio << "\n";
+        cout << "shards threads ops/s speedup\n";
+        for (int nshards : split_ints(shards))
+        {
+            double single = 0;
+            for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2)
+            {
+                double rate = measure(n, nshards, tolerance, nthreads, operations, hit_ratio);
+                if (nthreads == 1)
+                    single = rate;
+                cout << nshards << " " << nthreads << " " << rate << " " << rate / single << endl;
+            }
+        }
+    }
+    catch (exception &e)
+    {
+        cerr << "\ncache_benchmark has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,666 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "campaign.hpp"
+#include "campaign_ledger.hpp"
+#include "campaign_timings.hpp"
+#include "../../problems/cpp/problems.hpp"
+#ifdef USE_NOMAD
+#include "bimads_runner.hpp"
+#endif
+#ifdef CAMPAIGN_MPI
+#include "campaign_mpi.hpp"
+#endif
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*           Work-stealing scheduler of analytical campaigns       */
+/*-----------------------------------------------------------------*/
+//
+// Expands the (problem x family x variant x seed) jobs of a campaign and runs
+// them longest-first on a pool of workers (see campaign.hpp). Each job writes
+// <dir>/<problem>_<family>_<solver><variant>_<seed>.txt, the name used by the
+// generation scripts, and its output in <dir>/<run>.log. Each run is written
+// (or moved into the archive) as soon as its job ends, and the peak memory of
+// each job is measured on its whole process tree and kept in the ledger.
+//
+// Jobs are dealt longest-first by their durations predicted from the
+// previous campaigns (campaign_timings.hpp): this LPT order keeps the
+// makespan within 4/3 of the optimal one (Graham), it does not minimize it.
+// The predicted and actual makespans and the error of the predictions are
+// reported at the end.
+//
+// BiMADS is run by the campaign binary itself (a child process re-executes
+// it with --run-bimads) on the problems of problems/cpp. Any other solver is
+// an external command, e.g. DMulti-MADS with run_analytical_job.jl:
+//
+//   campaign -s dmultimads -P analytical_problems.txt -j 48
+//            -c "julia run_analytical_job.jl {problem} {family} {variant} {seed} {output}"
+//
+// Compile: g++ -O3 -std=c++17 -pthread campaign.cpp -o campaign -lz
+// with MPI:
+//   mpicxx -O3 -std=c++17 -pthread -DCAMPAIGN_MPI campaign.cpp -o campaign -lz
+// with BiMADS (NOMAD 3):
+//   g++ -O3 -std=c++17 -pthread -DUSE_NOMAD -I$NOMAD_HOME/src campaign.cpp -o campaign
+//       -L$NOMAD_HOME/lib -lnomad -lz
+//
+// Usage: campaign [-s solver] [-c command] [-P problem_list] [-p problem] [-f families]
+//                 [-v variants] [--seeds seeds] [-b budget] [-j workers] [-d dir]
+//                 [-a archive] [-l ledger] [-T timings] [-M memory] [--job-memory memory]
+//                 [--pin] [--smt use|reserve] [--mpi] [--bimads-subproblems k]
+//                 [--bimads-adaptive] [--bimads-deterministic] [--dry-run]
+//   -s : solver name used in the run names (default bimads)
+//   -c : command template of an external solver; {problem}, {family},
+//        {variant}, {seed}, {budget}, {n} and {output} are replaced
+//   -P : "name n m" problem list (default: the problems of problems/cpp)
+//   -f, -v, --seeds : comma-separated lists (defaults: 1,...,6; PB,EB,Penalty
+//        for external solvers and none for BiMADS; the 11 seeds of
+//        generate_analytical_dmultimads.jl)
+//   -b : evaluation budget of each job (default 30000)
+//   -a : move each finished run into a campaign archive
+//   -l : ledger of the completed runs (default <dir>/campaign.ledger); a
+//        campaign run again with the same ledger skips them, see
+//        campaign_ledger.hpp
+//   -T : durations of the previous jobs, used to predict those of the jobs
+//        (default <dir>/campaign.timings); each successful job is appended
+//   -M : memory budget in GB (default: none); a job starts only when its
+//        estimated memory fits in what the running jobs leave, whatever -j
+//   --job-memory : memory in GB of a job of a problem never run before, until
+//        a first job has finished (default 1)
+//   --pin : pin each worker's jobs to one CPU, alternating between sockets, with
+//        their memory on the NUMA node of the CPU; per-socket throughputs are
+//        reported at the end (see cpu_topology.hpp)
+//   --smt : with --pin, "reserve" leaves the SMT siblings of the used cores
+//        idle, "use" (default) gives them to workers once all cores are taken
+//   --mpi : distribute the jobs over MPI ranks instead of threads (compile
+//        with -DCAMPAIGN_MPI, see campaign_mpi.hpp): rank 0 dispatches and
+//        writes the outputs, the ledger and the archive, every other rank
+//        runs one job at a time; -j, -M and --pin are ignored, e.g.
+//          mpirun -np 5 --bind-to core campaign --mpi -s dmultimads -c "..."
+//   --bimads-subproblems : solve up to this number of subproblems of each
+//        BiMADS job at a time, sharing its evaluation cache and budget (see
+//        parallel_bimads.hpp); count them in -j and -M, and do not use --pin
+//   --bimads-adaptive : give the evaluations of each BiMADS job to the
+//        subproblems by the hypervolume they can add (implies
+//        --bimads-subproblems 1 if not given)
+//   --bimads-deterministic : solve the subproblems of each BiMADS job in
+//        rounds, so that its run only depends on its seed and
+//        --bimads-subproblems (see parallel_bimads.hpp)
+//   --dry-run : print the jobs, their predicted duration and worker, the
+//        predicted makespan, and exit
+
+const string SEEDS = "1234,1,4734,6652,3507,1121,3500,5816,2006,9622,6117";
+
+static vector<string> split(const string &s)
+{
+    vector<string> res;
+    size_t start = 0;
+    while (start <= s.size())
+    {
+        size_t end = s.find(',', start);
+        if (end == string::npos)
+            end = s.size();
+        res.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+    return res;
+}
+
+static vector<int> split_ints(const string &s)
+{
+    vector<int> res;
+    for (const string &v : split(s))
+    {
+        if (!v.empty())
+            res.push_back(atoi(v.c_str()));
+    }
+    return res;
+}
+
+static string self_executable()
+{
+    char buf[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+    if (len <= 0)
+        throw runtime_error("cannot find the campaign executable");
+    return string(buf, len);
+}
+
+// child process of a BiMADS job
+static int run_bimads_job(int argc, char **argv)
+{
+    const string arguments = "--run-bimads problem family seed budget output [subproblems [adaptive] [deterministic]]";
+    if (argc < 7 || argc > 10)
+        throw runtime_error(arguments);
+    bool adaptive = false, deterministic = false;
+    for (int i = 8; i < argc; ++i)
+    {
+        string option = argv[i];
+        if (option == "adaptive" && !adaptive && !deterministic)
+            adaptive = true;
+        else if (option == "deterministic" && !deterministic)
+            deterministic = true;
+        else
+            throw runtime_error(arguments);
+    }
+    const bbproblems::Problem *pb = bbproblems::find_problem(argv[2]);
+    if (pb == nullptr)
+        throw runtime_error(string("unknown problem ") + argv[2]);
+#ifdef USE_NOMAD
+    int family = atoi(argv[3]);
+    if (argc >= 8)
+        return run_parallel_bimads(argc, argv, problem_blackbox(*pb, family), atoi(argv[4]), atoi(argv[5]),
+                                   argv[6], atoi(argv[7]), adaptive, deterministic);
+    return run_bimads(argc, argv, *pb, family, atoi(argv[4]), atoi(argv[5]), argv[6]);
+#else
+    throw runtime_error("BiMADS is not available: compile with -DUSE_NOMAD");
+#endif
+}
+
+static void usage()
+{
+    cerr << "Usage: campaign [-s solver] [-c command] [-P problem_list] [-p problem] [-f families]\n"
+            "                [-v variants] [--seeds seeds] [-b budget] [-j workers] [-d dir]\n"
+            "                [-a archive] [-l ledger] [-T timings] [-M memory] [--job-memory memory]\n"
+            "                [--pin] [--smt use|reserve] [--mpi] [--bimads-subproblems k]\n"
+            "                [--bimads-adaptive] [--bimads-deterministic] [--dry-run]\n";
+    exit(EXIT_FAILURE);
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    string solver = "bimads";
+    string command, problem_list, name, archive_path, ledger_path, timings_path;
+    double memory_gb = 0, job_memory_gb = 1;
+    bool pin = false, reserve_siblings = false, use_mpi = false, adaptive = false;
+    bool deterministic = false;
+    string families = "1,2,3,4,5,6", variants = "-", seeds = SEEDS;
+    int budget = 30000, subproblems = 0;
+    int nworkers = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    string dir = ".";
+    bool dry_run = false;
+
+    if (argc > 1 && string(argv[1]) == "--run-bimads")
+    {
+        try
+        {
+            return run_bimads_job(argc, argv);
+        }
+        catch (exception &e)
+        {
+            cerr << "\ncampaign has been interrupted (" << e.what() << ")\n\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-s" && i + 1 < argc)
+            solver = argv[++i];
+        else if (arg == "-c" && i + 1 < argc)
+            command = argv[++i];
+        else if (arg == "-P" && i + 1 < argc)
+            problem_list = argv[++i];
+        else if (arg == "-p" && i + 1 < argc)
+            name = argv[++i];
+        else if (arg == "-f" && i + 1 < argc)
+            families = argv[++i];
+        else if (arg == "-v" && i + 1 < argc)
+            variants = argv[++i];
+        else if (arg == "--seeds" && i + 1 < argc)
+            seeds = argv[++i];
+        else if (arg == "-b" && i + 1 < argc)
+            budget = atoi(argv[++i]);
+        else if (arg == "-j" && i + 1 < argc)
+            nworkers = max(1, atoi(argv[++i]));
+        else if (arg == "-d" && i + 1 < argc)
+            dir = argv[++i];
+        else if (arg == "-a" && i + 1 < argc)
+            archive_path = argv[++i];
+        else if (arg == "-l" && i + 1 < argc)
+            ledger_path = argv[++i];
+        else if (arg == "-T" && i + 1 < argc)
+            timings_path = argv[++i];
+        else if (arg == "-M" && i + 1 < argc)
+            memory_gb = atof(argv[++i]);
+        else if (arg == "--job-memory" && i + 1 < argc)
+            job_memory_gb = atof(argv[++i]);
+        else if (arg == "--pin")
+            pin = true;
+        else if (arg == "--smt" && i + 1 < argc)
+        {
+            string smt = argv[++i];
+            if (smt != "use" && smt != "reserve")
+                usage();
+            reserve_siblings = (smt == "reserve");
+        }
+        else if (arg == "--mpi")
+            use_mpi = true;
+        else if (arg == "--bimads-subproblems" && i + 1 < argc)
+            subproblems = max(1, atoi(argv[++i]));
+        else if (arg == "--bimads-adaptive")
+            adaptive = true;
+        else if (arg == "--bimads-deterministic")
+            deterministic = true;
+        else if (arg == "--dry-run")
+            dry_run = true;
+        else
+            usage();
+    }
+    if (use_mpi)
+        pin = false;
+    bool bimads = command.empty();
+    if (bimads && solver != "bimads")
+        usage();
+    if (variants == "-")
+        variants = bimads ? "" : "PB,EB,Penalty";
+
+    try
+    {
+#ifndef USE_NOMAD
+        if (bimads && !dry_run)
+            throw runtime_error("BiMADS is not available: compile with -DUSE_NOMAD");
+#endif
+        string self = bimads ? self_executable() : "";
+
+        // runs one job in a child process
+        auto launch = [&](const Job &job, const function<void(long)> &monitor, const Placement &placement)
+        {
+            string run_name = job.key.to_string();
+            string output = dir + "/" + run_name + ".txt";
+            string log = dir + "/" + run_name + ".log";
+            vector<string> argv = job_argv(job, output, command, self, subproblems, adaptive, deterministic);
+            // the output of an interrupted run is partial
+            remove(output.c_str());
+            return run_process(argv, log, monitor, placement);
+        };
+
+#ifdef CAMPAIGN_MPI
+        int rank = 0;
+        if (use_mpi && !dry_run)
+        {
+            MPI_Init(&argc, &argv);
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            MPI_Comm_size(MPI_COMM_WORLD, &nworkers);
+            --nworkers; // rank 0 dispatches
+        }
+        // worker ranks run jobs and send their output to rank 0
+        if (rank > 0)
+        {
+            mpi_serve([&](const Job &job, string &content, bool &has_output)
+                      {
+                JobResult res = launch(job, nullptr, Placement());
+                string output = dir + "/" + job.key.to_string() + ".txt";
+                ifstream in(output, ios::binary);
+                if (in)
+                {
+                    ostringstream buf;
+                    buf << in.rdbuf();
+                    content = buf.str();
+                    has_output = true;
+                    in.close();
+                    remove(output.c_str());
+                }
+                return res; });
+            MPI_Finalize();
+            return EXIT_SUCCESS;
+        }
+#else
+        if (use_mpi)
+            throw runtime_error("the MPI mode is not available: compile with -DCAMPAIGN_MPI");
+#endif
+
+        vector<CampaignProblem> problems;
+        if (problem_list.empty())
+        {
+            for (const bbproblems::Problem &pb : bbproblems::all_problems())
+                problems.push_back({pb.name, pb.n, pb.m});
+        }
+        else
+            problems = read_problem_list(problem_list);
+        if (!name.empty())
+        {
+            problems.erase(remove_if(problems.begin(), problems.end(), [&](const CampaignProblem &pb)
+                                     { return pb.name != name; }),
+                           problems.end());
+            if (problems.empty())
+                throw runtime_error("unknown problem " + name);
+        }
+        // BiMADS is bi-objective: not the DTLZ and WFG problems of more
+        // objectives
+        for (const CampaignProblem &pb : problems)
+        {
+            const bbproblems::Problem *cpp = bbproblems::find_problem(pb.name);
+            if (bimads && (cpp == nullptr || cpp->m != 2))
+                throw runtime_error("no BiMADS version of " + pb.name);
+        }
+        for (int fam : split_ints(families))
+        {
+            if (fam < 1 || fam > bbproblems::NB_FAMILIES)
+                throw runtime_error("invalid family " + to_string(fam));
+        }
+
+        vector<Job> jobs = expand_jobs(problems, split_ints(families), solver, split(variants),
+                                       split_ints(seeds), budget);
+
+        unique_ptr<CampaignArchive> archive;
+        if (!archive_path.empty())
+            archive.reset(new CampaignArchive(archive_path, true));
+        CampaignLedger ledger(ledger_path.empty() ? dir + "/campaign.ledger" : ledger_path);
+
+        // output of a run, from its file or from the archive
+        auto read_output = [&](const string &run_name, string &content)
+        {
+            ifstream in(dir + "/" + run_name + ".txt", ios::binary);
+            if (in)
+            {
+                ostringstream buf;
+                buf << in.rdbuf();
+                content = buf.str();
+                return true;
+            }
+            if (archive && archive->contains(run_name))
+            {
+                content = archive->read(run_name);
+                return true;
+            }
+            return false;
+        };
+
+        // skip the runs completed by a previous execution
+        size_t nb_jobs = jobs.size(), nb_requeued = 0;
+        vector<Job> todo;
+        for (const Job &job : jobs)
+        {
+            string run_name = job.key.to_string();
+            string content;
+            if (ledger.previous().count(run_name) == 0)
+                todo.push_back(job);
+            else if (read_output(run_name, content) && ledger.is_done(run_name, content))
+                continue;
+            else
+            {
+                todo.push_back(job);
+                ++nb_requeued;
+            }
+        }
+        jobs.swap(todo);
+        if (nb_jobs > jobs.size() || nb_requeued > 0)
+            cerr << nb_jobs - jobs.size() << " jobs already done, " << nb_requeued
+                 << " interrupted or failed jobs run again" << endl;
+
+        // predicted durations, longest first
+        TimingModel timings(timings_path.empty() ? dir + "/campaign.timings" : timings_path);
+        for (Job &job : jobs)
+        {
+            int level;
+            job.cost = timings.predict(job, level);
+        }
+        stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b)
+                    { return a.cost > b.cost; });
+        vector<int> prediction_level(jobs.size());
+        size_t nb_timed = 0;
+        for (size_t k = 0; k < jobs.size(); ++k)
+        {
+            timings.predict(jobs[k], prediction_level[k]);
+            nb_timed += (prediction_level[k] > 0);
+        }
+        const string unit = timings.empty() ? " cost units" : " s";
+        double makespan = predicted_makespan(jobs, nworkers);
+        if (!jobs.empty())
+            cerr << "predicted makespan on " << nworkers << " workers: " << makespan << unit << " ("
+                 << nb_timed << "/" << jobs.size() << " jobs predicted from previous timings)" << endl;
+
+        // CPU of each worker; with more workers than CPUs, several workers
+        // share a CPU (oversubscription)
+        vector<Placement> placements(nworkers);
+        if (pin)
+        {
+            vector<Placement> cpus = worker_placements(hardware_threads(), reserve_siblings);
+            if (cpus.empty())
+                throw runtime_error("cannot read the CPU topology");
+            for (int w = 0; w < nworkers; ++w)
+                placements[w] = cpus[w % cpus.size()];
+        }
+
+        if (dry_run)
+        {
+            vector<int> worker = WorkStealingQueues(jobs, nworkers).assignment();
+            for (size_t k = 0; k < jobs.size(); ++k)
+            {
+                cout << jobs[k].key.to_string() << " " << jobs[k].cost << " " << worker[k];
+                if (pin)
+                    cout << " cpu " << placements[worker[k]].cpu << " socket " << placements[worker[k]].socket;
+                cout << "\n";
+            }
+            return EXIT_SUCCESS;
+        }
+
+
+        // peak memory of the jobs of each problem, from the ledger and then
+        // from the finished jobs; the memory of a job is estimated by the
+        // peak of its problem, else by the largest peak seen
+        MemoryBudget memory(static_cast<long>(memory_gb * 1024 * 1024));
+        map<string, long> problem_peak_kb;
+        long largest_peak_kb = 0;
+        mutex peak_mtx;
+        for (const auto &r : ledger.previous())
+        {
+            if (r.second.state == "done")
+            {
+                long &peak = problem_peak_kb[RunKey::parse(r.first).problem];
+                peak = max(peak, r.second.max_rss_kb);
+                largest_peak_kb = max(largest_peak_kb, peak);
+            }
+        }
+        auto estimate_memory = [&](const Job &job)
+        {
+            lock_guard<mutex> guard(peak_mtx);
+            auto it = problem_peak_kb.find(job.key.problem);
+            if (it != problem_peak_kb.end())
+                return it->second;
+            return largest_peak_kb > 0 ? largest_peak_kb : static_cast<long>(job_memory_gb * 1024 * 1024);
+        };
+
+        auto run = [&](const Job &job, int w)
+        {
+            long reserved = estimate_memory(job);
+            memory.acquire(reserved);
+            JobResult res;
+            try
+            {
+                ledger.start(job.key.to_string());
+                res = launch(job, [&](long rss_kb)
+                             { memory.update(reserved, rss_kb); },
+                             placements[w]);
+            }
+            catch (...)
+            {
+                memory.release(reserved);
+                throw;
+            }
+            memory.release(reserved);
+            return res;
+        };
+
+        auto start = chrono::steady_clock::now();
+        size_t nb_done = 0, nb_failed = 0;
+        auto done = [&](size_t k, JobResult &res)
+        {
+            const Job &job = jobs[k];
+            string run_name = job.key.to_string();
+            string output = dir + "/" + run_name + ".txt";
+            try
+            {
+                string content;
+                if (res.status == 0 && !read_output(run_name, content))
+                    res.status = -1; // no output
+                if (res.status == 0 && archive)
+                {
+                    archive->append(run_name, content);
+                    remove(output.c_str());
+                }
+                if (res.status == 0)
+                {
+                    ledger.done(run_name, content, res.seconds, res.max_rss_kb);
+                    timings.record(job, res.seconds);
+                }
+                else
+                    ledger.failed(run_name, res.status);
+            }
+            catch (exception &e)
+            {
+                cerr << run_name << ": " << e.what() << endl;
+                res.status = -1;
+            }
+            {
+                lock_guard<mutex> guard(peak_mtx);
+                long &peak = problem_peak_kb[job.key.problem];
+                peak = max(peak, res.max_rss_kb);
+                largest_peak_kb = max(largest_peak_kb, peak);
+            }
+            ++nb_done;
+            nb_failed += (res.status != 0);
+            cerr << "[" << nb_done << "/" << jobs.size() << "] " << run_name
+                 << (res.status == 0 ? " done" : " FAILED (status " + to_string(res.status) + ")")
+                 << " in " << res.seconds << " s on worker " << res.worker
+                 << (res.stolen ? " (stolen)" : "") << ", peak memory "
+                 << res.max_rss_kb / 1024 << " MB" << endl;
+        };
+
+        vector<JobResult> results;
+#ifdef CAMPAIGN_MPI
+        if (use_mpi)
+        {
+            results = mpi_dispatch(
+                jobs, [&](size_t k)
+                { ledger.start(jobs[k].key.to_string()); },
+                [&](size_t k, const string &content)
+                {
+                    string output = dir + "/" + jobs[k].key.to_string() + ".txt";
+                    ofstream out(output, ios::binary);
+                    out << content;
+                },
+                done);
+            MPI_Finalize();
+        }
+        else
+#endif
+            results = run_jobs(jobs, nworkers, run, done);
+
+        // load balance
+        vector<double> busy(nworkers, 0);
+        vector<int> count(nworkers, 0);
+        for (const JobResult &res : results)
+        {
+            busy[res.worker] += res.seconds;
+            ++count[res.worker];
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cerr << "\n"
+             << jobs.size() - nb_failed << "/" << jobs.size() << " jobs done in " << elapsed << " s\n";
+
+        // accuracy of the predictions
+        cerr << "predicted makespan " << makespan << unit << ", actual " << elapsed << " s\n";
+        double abs_error = 0;
+        size_t nb_compared = 0;
+        for (size_t k = 0; k < jobs.size(); ++k)
+        {
+            if (prediction_level[k] > 0 && results[k].status == 0 && jobs[k].cost > 0)
+            {
+                abs_error += fabs(results[k].seconds - jobs[k].cost) / jobs[k].cost;
+                ++nb_compared;
+            }
+        }
+        if (nb_compared > 0)
+            cerr << "mean error of the predicted job durations: " << 100 * abs_error / nb_compared << " % over "
+                 << nb_compared << " jobs\n";
+        for (int w = 0; w < nworkers; ++w)
+        {
+            cerr << "worker " << w << ": " << count[w] << " jobs, busy " << busy[w] << " s";
+            if (pin)
+                cerr << ", cpu " << placements[w].cpu;
+            cerr << "\n";
+        }
+
+        // throughput of each socket, to compare levels of oversubscription
+        if (pin)
+        {
+            map<int, size_t> socket_jobs;
+            map<int, double> socket_evals, socket_busy;
+            map<int, int> socket_workers;
+            for (int w = 0; w < nworkers; ++w)
+                ++socket_workers[placements[w].socket];
+            for (size_t k = 0; k < jobs.size(); ++k)
+            {
+                int socket = placements[results[k].worker].socket;
+                socket_busy[socket] += results[k].seconds;
+                if (results[k].status == 0)
+                {
+                    ++socket_jobs[socket];
+                    socket_evals[socket] += jobs[k].budget;
+                }
+            }
+            for (const auto &sw : socket_workers)
+            {
+                int socket = sw.first;
+                cerr << "socket " << socket << ": " << sw.second << " workers, " << socket_jobs[socket]
+                     << " jobs, " << socket_jobs[socket] / elapsed * 3600 << " jobs/h, "
+                     << socket_evals[socket] / elapsed << " evaluations/s, busy " << socket_busy[socket]
+                     << " s\n";
+            }
+        }
+
+        // memory
+        if (!use_mpi)
+        {
+            cerr << "\nlargest memory reserved at once: " << memory.peak() / 1024 << " MB";
+            if (memory_gb > 0)
+                cerr << " (budget " << memory_gb * 1024 << " MB)";
+        }
+        cerr << "\npeak memory of one job, per problem:\n";
+        vector<pair<long, string>> peaks;
+        for (const Job &job : jobs)
+            peaks.push_back({problem_peak_kb[job.key.problem], job.key.problem});
+        sort(peaks.rbegin(), peaks.rend());
+        peaks.erase(unique(peaks.begin(), peaks.end()), peaks.end());
+        for (const auto &p : peaks)
+        {
+            cerr << p.second << " " << p.first / 1024 << " MB\n";
+        }
+        if (nb_failed > 0)
+            return EXIT_FAILURE;
+    }
+    catch (exception &e)
+    {
+        cerr << "\ncampaign has been interrupted (" << e.what() << ")\n\n";
+#ifdef CAMPAIGN_MPI
+        // the other ranks wait for rank 0
+        int initialized, finalized;
+        MPI_Initialized(&initialized);
+        MPI_Finalized(&finalized);
+        if (initialized && !finalized)
+            MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+#endif
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,511 @@
+#ifndef CAMPAIGN_HPP
+#define CAMPAIGN_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <linux/mempolicy.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "campaign_archive.hpp"
+#include "cpu_topology.hpp"
+#include "../../problems/cpp/constraints.hpp"
+
+/*-----------------------------------------------------------------*/
+/*     Campaign of (problem, family, variant, seed) jobs            */
+/*-----------------------------------------------------------------*/
+//
+// generate_analytical_dmultimads.jl gives one problem to each worker, which
+// then runs its 11 seeds x 3 variants x 6 families serially: a 30-variable
+// problem keeps a core for days while the others are idle. Here the whole
+// job matrix is expanded, each job gets an estimated cost, and jobs are
+// dealt longest-first to per-worker queues. A worker whose queue is empty
+// steals the longest waiting job of the most loaded queue.
+//
+// Jobs run as child processes, which isolates the solvers (NOMAD 3 is not
+// thread-safe, Julia and MATLAB are separate processes anyway) and gives
+// their peak memory through wait4.
+
+struct CampaignProblem
+{
+    std::string name;
+    int n; // number of variables
+    int m; // number of objectives
+};
+
+struct Job
+{
+    RunKey key;
+    int n;
+    int m;
+    int nb_constraints;
+    int budget; // maximum number of evaluations
+    double cost; // estimated, arbitrary unit
+};
+
+struct JobResult
+{
+    bool run = false;
+    int status = -1; // exit status, 0 on success
+    double seconds = 0;
+    long max_rss_kb = 0;
+    int worker = -1;
+    bool stolen = false; // taken from the queue of another worker
+};
+
+// "name n m" lines, '#' starts a comment
+inline std::vector<CampaignProblem> read_problem_list(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("cannot open " + path);
+
+    std::vector<CampaignProblem> problems;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream row(line);
+        CampaignProblem pb;
+        if (row >> pb.name >> pb.n >> pb.m)
+            problems.push_back(pb);
+    }
+    return problems;
+}
+
+// Rough cost model: each of the budget evaluations costs one unit per
+// variable (read by the problem, moved by the poll) and one per output (m
+// objectives and nc constraints), i.e. budget * (n + m + nc). Only the
+// ranking of the jobs matters.
+inline double estimate_cost(int n, int m, int nb_constraints, int budget)
+{
+    return static_cast<double>(budget) * (n + m + nb_constraints);
+}
+
+// all jobs, longest first; as in generate_analytical_dmultimads.jl, problems
+// with less than 3 variables are skipped
+inline std::vector<Job> expand_jobs(const std::vector<CampaignProblem> &problems,
+                                    const std::vector<int> &families,
+                                    const std::string &solver,
+                                    const std::vector<std::string> &variants,
+                                    const std::vector<int> &seeds, int budget)
+{
+    std::vector<Job> jobs;
+    for (const CampaignProblem &pb : problems)
+    {
+        if (pb.n <= 2)
+            continue;
+        for (int seed : seeds)
+        {
+            for (const std::string &variant : variants)
+            {
+                for (int family : families)
+                {
+                    Job job;
+                    job.key.problem = pb.name;
+                    job.key.family = family;
+                    job.key.solver = solver;
+                    job.key.variant = variant;
+                    job.key.seed = seed;
+                    job.n = pb.n;
+                    job.m = pb.m;
+                    job.nb_constraints = bbproblems::nb_constraints(family, pb.n);
+                    job.budget = budget;
+                    job.cost = estimate_cost(job.n, job.m, job.nb_constraints, budget);
+                    jobs.push_back(job);
+                }
+            }
+        }
+    }
+    std::stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b)
+                     { return a.cost > b.cost; });
+    return jobs;
+}
+
+/*----------------------------------------*/
+/*          work-stealing queues          */
+/*----------------------------------------*/
+class WorkStealingQueues
+{
+    struct Queue
+    {
+        std::mutex mtx;
+        std::deque<size_t> jobs; // longest first
+        double work = 0;         // estimated cost of the waiting jobs
+    };
+
+    const std::vector<Job> &jobs;
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    bool take_front(Queue &q, size_t &job)
+    {
+        std::lock_guard<std::mutex> guard(q.mtx);
+        if (q.jobs.empty())
+            return false;
+        job = q.jobs.front();
+        q.jobs.pop_front();
+        q.work -= jobs[job].cost;
+        return true;
+    }
+
+public:
+    // jobs sorted longest first; each one goes to the least loaded queue
+    WorkStealingQueues(const std::vector<Job> &all_jobs, int nworkers) : jobs(all_jobs)
+    {
+        for (int w = 0; w < nworkers; ++w)
+        {
+            queues.emplace_back(new Queue());
+        }
+        for (size_t k = 0; k < jobs.size(); ++k)
+        {
+            Queue *least = queues[0].get();
+            for (auto &q : queues)
+            {
+                if (q->work < least->work)
+                    least = q.get();
+            }
+            least->jobs.push_back(k);
+            least->work += jobs[k].cost;
+        }
+    }
+
+    // next job of worker w, false when no job is left anywhere
+    bool pop(int w, size_t &job, bool &stolen)
+    {
+        stolen = false;
+        if (take_front(*queues[w], job))
+            return true;
+
+        stolen = true;
+        while (true)
+        {
+            Queue *victim = nullptr;
+            double most = 0;
+            for (auto &q : queues)
+            {
+                std::lock_guard<std::mutex> guard(q->mtx);
+                if (!q->jobs.empty() && (victim == nullptr || q->work > most))
+                {
+                    victim = q.get();
+                    most = q->work;
+                }
+            }
+            if (victim == nullptr)
+                return false;
+            // the victim may have been emptied in the meantime
+            if (take_front(*victim, job))
+                return true;
+        }
+    }
+
+    // worker of each job before any stealing, for --dry-run
+    std::vector<int> assignment() const
+    {
+        std::vector<int> worker(jobs.size(), -1);
+        for (size_t w = 0; w < queues.size(); ++w)
+        {
+            for (size_t k : queues[w]->jobs)
+                worker[k] = static_cast<int>(w);
+        }
+        return worker;
+    }
+};
+
+// Runs the jobs on nworkers threads. run(job, worker) executes one job and
+// returns its JobResult; done(job, result) is called after each job, under
+// a lock, to report or record it.
+template <class Runner, class Callback>
+std::vector<JobResult> run_jobs(const std::vector<Job> &jobs, int nworkers, Runner run, Callback done)
+{
+    WorkStealingQueues queues(jobs, nworkers);
+    std::vector<JobResult> results(jobs.size());
+    std::mutex mtx;
+
+    std::vector<std::thread> pool;
+    for (int w = 0; w < nworkers; ++w)
+    {
+        pool.emplace_back([&, w]()
+                          {
+            size_t k;
+            bool stolen;
+            while (queues.pop(w, k, stolen))
+            {
+                JobResult res;
+                try
+                {
+                    res = run(jobs[k], w);
+                }
+                catch (std::exception &e)
+                {
+                    std::cerr << jobs[k].key.to_string() << ": " << e.what() << std::endl;
+                    res.status = -1;
+                }
+                res.run = true;
+                res.worker = w;
+                res.stolen = stolen;
+                std::lock_guard<std::mutex> guard(mtx);
+                results[k] = res;
+                done(k, results[k]);
+            } });
+    }
+    for (std::thread &th : pool)
+    {
+        th.join();
+    }
+    return results;
+}
+
+/*----------------------------------------*/
+/*              subprocesses              */
+/*----------------------------------------*/
+
+// Resident memory (kB) of a process and of all its descendants, e.g. the
+// MATLAB engine started by a Julia job. 0 if the process is gone.
+inline long tree_rss_kb(pid_t root)
+{
+    std::map<pid_t, std::vector<pid_t>> children;
+    std::map<pid_t, long> rss;
+    long page_kb = sysconf(_SC_PAGESIZE) / 1024;
+
+    DIR *proc = opendir("/proc");
+    if (proc == nullptr)
+        return 0;
+    while (struct dirent *entry = readdir(proc))
+    {
+        pid_t pid = static_cast<pid_t>(std::atoi(entry->d_name));
+        if (pid <= 0)
+            continue;
+        std::ifstream stat(std::string("/proc/") + entry->d_name + "/stat");
+        std::string line;
+        if (!std::getline(stat, line))
+            continue;
+        // the command name may contain spaces: fields are counted after ')'
+        size_t paren = line.rfind(')');
+        if (paren == std::string::npos)
+            continue;
+        std::istringstream fields(line.substr(paren + 2));
+        std::string value;
+        pid_t ppid = 0;
+        long pages = 0;
+        for (int field = 3; field <= 24 && fields >> value; ++field)
+        {
+            if (field == 4)
+                ppid = static_cast<pid_t>(std::atol(value.c_str()));
+            else if (field == 24)
+                pages = std::atol(value.c_str());
+        }
+        children[ppid].push_back(pid);
+        rss[pid] = pages * page_kb;
+    }
+    closedir(proc);
+
+    long total = 0;
+    std::vector<pid_t> todo(1, root);
+    while (!todo.empty())
+    {
+        pid_t pid = todo.back();
+        todo.pop_back();
+        total += rss[pid];
+        for (pid_t child : children[pid])
+            todo.push_back(child);
+    }
+    return total;
+}
+
+// Runs argv (argv[0] is searched in PATH) with stdout and stderr redirected
+// to log (appended). The exit status is 128 + signal if the child was killed.
+// While the child runs, the memory of its process tree is sampled and given
+// to monitor(rss_kb) if any; max_rss_kb is the largest of these samples and
+// of the peak reported by wait4. A placement pins the child (and everything
+// it starts) to one CPU and makes its memory come from the given NUMA node
+// when possible.
+inline JobResult run_process(const std::vector<std::string> &argv, const std::string &log,
+                             const std::function<void(long)> &monitor = nullptr,
+                             const Placement &placement = Placement())
+{
+    // everything is prepared before fork: the child only calls
+    // async-signal-safe functions
+    std::vector<char *> args;
+    for (const std::string &a : argv)
+    {
+        args.push_back(const_cast<char *>(a.c_str()));
+    }
+    args.push_back(nullptr);
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (placement.cpu >= 0)
+        CPU_SET(placement.cpu, &cpus);
+    unsigned long nodes = (placement.node >= 0 && placement.node < 64) ? 1UL << placement.node : 0;
+
+    JobResult res;
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0)
+        throw std::runtime_error("cannot fork");
+    if (pid == 0)
+    {
+        int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd >= 0)
+        {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        if (placement.cpu >= 0)
+            sched_setaffinity(0, sizeof(cpus), &cpus);
+        if (nodes != 0)
+            syscall(SYS_set_mempolicy, MPOL_PREFERRED, &nodes, 8 * sizeof(nodes));
+        execvp(args[0], args.data());
+        _exit(127);
+    }
+
+    // sample often at the beginning, where short jobs end, then every second
+    int status;
+    struct rusage usage;
+    std::chrono::milliseconds period(10);
+    while (true)
+    {
+        pid_t r = wait4(pid, &status, WNOHANG, &usage);
+        if (r == pid)
+            break;
+        if (r < 0 && errno != EINTR)
+            throw std::runtime_error("cannot wait for " + argv[0]);
+
+        long rss = tree_rss_kb(pid);
+        res.max_rss_kb = std::max(res.max_rss_kb, rss);
+        if (monitor)
+            monitor(rss);
+        std::this_thread::sleep_for(period);
+        period = std::min(2 * period, std::chrono::milliseconds(1000));
+    }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    res.max_rss_kb = std::max(res.max_rss_kb, static_cast<long>(usage.ru_maxrss));
+    res.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    return res;
+}
+
+/*----------------------------------------*/
+/*             memory budget              */
+/*----------------------------------------*/
+
+// Memory reserved by the running jobs. A job starts when its estimated
+// memory fits in the budget, or when no other job runs (a job larger than
+// the budget runs alone). A job measured above its reservation grows it, so
+// that the next jobs wait for the memory actually used.
+class MemoryBudget
+{
+    long budget_kb; // <= 0: no limit
+    long reserved_kb = 0;
+    long peak_kb = 0;
+    std::mutex mtx;
+    std::condition_variable released;
+
+public:
+    explicit MemoryBudget(long kb) : budget_kb(kb) {}
+
+    // blocks until kb can be reserved
+    void acquire(long kb)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        released.wait(lock, [&]()
+                      { return budget_kb <= 0 || reserved_kb == 0 || reserved_kb + kb <= budget_kb; });
+        reserved_kb += kb;
+        peak_kb = std::max(peak_kb, reserved_kb);
+    }
+
+    // a job holding reserved kB now uses used kB
+    void update(long &reserved, long used)
+    {
+        std::lock_guard<std::mutex> guard(mtx);
+        if (used > reserved)
+        {
+            reserved_kb += used - reserved;
+            reserved = used;
+            peak_kb = std::max(peak_kb, reserved_kb);
+        }
+    }
+
+    void release(long kb)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            reserved_kb -= kb;
+        }
+        released.notify_all();
+    }
+
+    // largest memory reserved at once
+    long peak() const
+    {
+        return peak_kb;
+    }
+};
+
+// Replaces {problem}, {family}, {variant}, {seed}, {budget}, {n} and
+// {output} in a command template.
+inline std::string expand_command(std::string command, const Job &job, const std::string &output)
+{
+    const std::pair<std::string, std::string> fields[] = {
+        {"{problem}", job.key.problem},
+        {"{family}", std::to_string(job.key.family)},
+        {"{variant}", job.key.variant},
+        {"{seed}", std::to_string(job.key.seed)},
+        {"{budget}", std::to_string(job.budget)},
+        {"{n}", std::to_string(job.n)},
+        {"{output}", output}};
+    for (const auto &field : fields)
+    {
+        size_t pos;
+        while ((pos = command.find(field.first)) != std::string::npos)
+            command.replace(pos, field.first.size(), field.second);
+    }
+    return command;
+}
+
+// Command line of the child process of a job: for BiMADS (empty command),
+// the campaign binary self with --run-bimads and, with subproblems > 0,
+// adaptive or deterministic, the number of concurrent subproblems,
+// "adaptive" and "deterministic"; otherwise the expanded command, through sh.
+inline std::vector<std::string> job_argv(const Job &job, const std::string &output, const std::string &command,
+                                         const std::string &self, int subproblems, bool adaptive,
+                                         bool deterministic = false)
+{
+    std::vector<std::string> argv;
+    if (command.empty())
+    {
+        argv = {self, "--run-bimads", job.key.problem, std::to_string(job.key.family),
+                std::to_string(job.key.seed), std::to_string(job.budget), output};
+        if (subproblems > 0 || adaptive || deterministic)
+            argv.push_back(std::to_string(std::max(1, subproblems)));
+        if (adaptive)
+            argv.push_back("adaptive");
+        if (deterministic)
+            argv.push_back("deterministic");
+    }
+    else
+        argv = {"/bin/sh", "-c", expand_command(command, job, output)};
+    return argv;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "campaign_archive.hpp"
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*            Command line access to campaign archives             */
+/*-----------------------------------------------------------------*/
+//
+// Compile: g++ -O3 -std=c++17 campaign_archive.cpp -o campaign_archive -lz
+//
+// Usage:
+//   campaign_archive add <archive> <run files...>  pack loose run files, the
+//                                                 key being the file name
+//                                                 without ".txt"
+//   campaign_archive list <archive>                key, raw and compressed sizes
+//   campaign_archive get <archive> <key> [file]    extract one run
+//
+// Examples:
+//   campaign_archive add campaign.dmma *_dmultimads*_*.txt
+//   campaign_archive get campaign.dmma L2ZDT1_1_dmultimadsPB_1234 run.txt
+
+static void usage()
+{
+    cerr << "Usage: campaign_archive add <archive> <run files...>\n"
+            "       campaign_archive list <archive>\n"
+            "       campaign_archive get <archive> <key> [file]\n";
+    exit(EXIT_FAILURE);
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+        usage();
+    string command = argv[1];
+    string path = argv[2];
+
+    try
+    {
+        if (command == "add")
+        {
+            CampaignArchive archive(path, true);
+            for (int i = 3; i < argc; ++i)
+            {
+                ifstream in(argv[i], ios::binary);
+                if (!in)
+                    throw runtime_error(string("cannot open ") + argv[i]);
+                ostringstream content;
+                content << in.rdbuf();
+                archive.append(RunKey::parse(argv[i]).to_string(), content.str());
+            }
+        }
+        else if (command == "list" && argc == 3)
+        {
+            CampaignArchive archive(path);
+            for (const auto &kv : archive.entries())
+            {
+                cout << kv.first << " " << kv.second.raw_size << " " << kv.second.compressed_size << "\n";
+            }
+        }
+        else if (command == "get" && (argc == 4 || argc == 5))
+        {
+            CampaignArchive archive(path);
+            string content = archive.read(argv[3]);
+            if (argc == 5)
+            {
+                ofstream out(argv[4], ios::binary);
+                out << content;
+                if (!out)
+                    throw runtime_error(string("cannot write ") + argv[4]);
+            }
+            else
+                cout << content;
+        }
+        else
+            usage();
+    }
+    catch (exception &e)
+    {
+        cerr << "\ncampaign_archive has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,384 @@
+#ifndef CAMPAIGN_ARCHIVE_HPP
+#define CAMPAIGN_ARCHIVE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include <zlib.h>
+
+/*-----------------------------------------------------------------*/
+/*      Packed archive of campaign runs with a trailer index       */
+/*-----------------------------------------------------------------*/
+//
+// Replaces the thousands of loose files "<pb>_<family>_<solver><variant>_<seed>.txt"
+// of a campaign by one file:
+//
+//   chunk_1 .. chunk_k | index | footer
+//
+// Each chunk is a ChunkHeader, the key and the zlib-compressed content of
+// one run. The index lists (key, offset, sizes, crc) of the live chunks and
+// the fixed-size footer at the end of the file gives its position.
+//
+// Writers lock the whole file (fcntl, which also works on NFS), write the
+// new chunk where the old index started, then a new index and footer. A
+// crash can only damage the index: it is then rebuilt by scanning the chunks,
+// whose compressed bytes are checked with their crc32. Chunks are never
+// rewritten, so readers holding an older index stay valid.
+//
+// Readers load the index once and pread only the chunk of the requested run.
+//
+// Link with -lz.
+
+// (problem, family, solver, variant, seed) of a run, e.g.
+// "L2ZDT1_1_dmultimadsPB_1234" = (L2ZDT1, 1, dmultimads, PB, 1234)
+struct RunKey
+{
+    std::string problem;
+    int family = 0;
+    std::string solver;  // dmultimads, bimads, nsgaii...
+    std::string variant; // PB, EB, Penalty or empty
+    int seed = 0;
+
+    std::string to_string() const
+    {
+        return problem + "_" + std::to_string(family) + "_" + solver + variant + "_" + std::to_string(seed);
+    }
+
+    // parse a run name or file name (directories and ".txt" are ignored)
+    static RunKey parse(std::string name)
+    {
+        size_t slash = name.rfind('/');
+        if (slash != std::string::npos)
+            name = name.substr(slash + 1);
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0)
+            name.resize(name.size() - 4);
+
+        size_t p3 = name.rfind('_');
+        size_t p2 = (p3 == std::string::npos || p3 == 0) ? std::string::npos : name.rfind('_', p3 - 1);
+        size_t p1 = (p2 == std::string::npos || p2 == 0) ? std::string::npos : name.rfind('_', p2 - 1);
+        if (p1 == std::string::npos)
+            throw std::runtime_error("invalid run name " + name);
+
+        RunKey key;
+        key.problem = name.substr(0, p1);
+        key.family = std::atoi(name.substr(p1 + 1, p2 - p1 - 1).c_str());
+        std::string solver = name.substr(p2 + 1, p3 - p2 - 1);
+        key.seed = std::atoi(name.substr(p3 + 1).c_str());
+        for (const char *variant : {"PB", "EB", "Penalty"})
+        {
+            size_t l = std::strlen(variant);
+            if (solver.size() > l && solver.compare(solver.size() - l, l, variant) == 0)
+            {
+                key.variant = variant;
+                solver.resize(solver.size() - l);
+                break;
+            }
+        }
+        key.solver = solver;
+        return key;
+    }
+};
+
+class CampaignArchive
+{
+public:
+    struct Entry
+    {
+        uint64_t offset;          // of the chunk header
+        uint64_t compressed_size; // of the content
+        uint64_t raw_size;
+        uint32_t crc; // crc32 of the compressed content
+        uint32_t reserved;
+    };
+
+private:
+    static constexpr char CHUNK_MAGIC[4] = {'D', 'M', 'M', 'C'};
+    static constexpr char INDEX_MAGIC[8] = {'D', 'M', 'M', 'A', 'I', 'D', 'X', '1'};
+
+    struct ChunkHeader
+    {
+        char magic[4];
+        uint32_t key_size;
+        uint64_t raw_size;
+        uint64_t compressed_size;
+        uint32_t crc;
+        uint32_t reserved;
+    };
+
+    struct Footer
+    {
+        uint64_t index_offset; // also the end of the chunks
+        uint64_t index_size;
+        uint32_t index_crc;
+        uint32_t count;
+        char magic[8];
+    };
+
+    std::string path;
+    int fd = -1;
+    std::map<std::string, Entry> index;
+    uint64_t data_end = 0;
+
+    static uint32_t crc(const void *data, size_t size)
+    {
+        return static_cast<uint32_t>(crc32(0L, static_cast<const Bytef *>(data), static_cast<uInt>(size)));
+    }
+
+    void read_exact(void *buf, size_t size, uint64_t offset) const
+    {
+        char *p = static_cast<char *>(buf);
+        while (size > 0)
+        {
+            ssize_t r = pread(fd, p, size, static_cast<off_t>(offset));
+            if (r <= 0)
+                throw std::runtime_error(path + ": unexpected end of file");
+            p += r;
+            size -= r;
+            offset += r;
+        }
+    }
+
+    void write_exact(const void *buf, size_t size, uint64_t offset)
+    {
+        const char *p = static_cast<const char *>(buf);
+        while (size > 0)
+        {
+            ssize_t w = pwrite(fd, p, size, static_cast<off_t>(offset));
+            if (w <= 0)
+                throw std::runtime_error(path + ": write error");
+            p += w;
+            size -= w;
+            offset += w;
+        }
+    }
+
+    void lock(short type)
+    {
+        struct flock fl;
+        std::memset(&fl, 0, sizeof(fl));
+        fl.l_type = type;
+        fl.l_whence = SEEK_SET;
+        if (fcntl(fd, F_SETLKW, &fl) != 0 && type != F_UNLCK)
+            throw std::runtime_error(path + ": cannot lock");
+    }
+
+    uint64_t file_size() const
+    {
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+            throw std::runtime_error(path + ": cannot stat");
+        return static_cast<uint64_t>(st.st_size);
+    }
+
+    // false if the footer or the index is missing or damaged
+    bool load_index()
+    {
+        index.clear();
+        data_end = 0;
+        uint64_t size = file_size();
+        if (size == 0)
+            return true;
+        if (size < sizeof(Footer))
+            return false;
+
+        Footer footer;
+        read_exact(&footer, sizeof(footer), size - sizeof(footer));
+        if (std::memcmp(footer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+            footer.index_offset + footer.index_size + sizeof(Footer) != size)
+            return false;
+
+        std::vector<char> buf(footer.index_size);
+        if (!buf.empty())
+            read_exact(buf.data(), buf.size(), footer.index_offset);
+        if (crc(buf.data(), buf.size()) != footer.index_crc)
+            return false;
+
+        size_t pos = 0;
+        for (uint32_t k = 0; k < footer.count; ++k)
+        {
+            uint32_t key_size;
+            Entry e;
+            if (pos + sizeof(key_size) > buf.size())
+                return false;
+            std::memcpy(&key_size, &buf[pos], sizeof(key_size));
+            pos += sizeof(key_size);
+            if (pos + key_size + sizeof(Entry) > buf.size())
+                return false;
+            std::string key(&buf[pos], key_size);
+            pos += key_size;
+            std::memcpy(&e, &buf[pos], sizeof(Entry));
+            pos += sizeof(Entry);
+            index[key] = e;
+        }
+        data_end = footer.index_offset;
+        return true;
+    }
+
+    // rebuild the index from the valid chunks at the beginning of the file
+    void recover_index()
+    {
+        index.clear();
+        uint64_t size = file_size();
+        uint64_t pos = 0;
+        std::vector<char> buf;
+        while (pos + sizeof(ChunkHeader) <= size)
+        {
+            ChunkHeader h;
+            read_exact(&h, sizeof(h), pos);
+            uint64_t end = pos + sizeof(h) + h.key_size + h.compressed_size;
+            if (std::memcmp(h.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 || end > size)
+                break;
+            std::string key(h.key_size, '\0');
+            read_exact(&key[0], h.key_size, pos + sizeof(h));
+            buf.resize(h.compressed_size);
+            if (!buf.empty())
+                read_exact(buf.data(), buf.size(), pos + sizeof(h) + h.key_size);
+            if (crc(buf.data(), buf.size()) != h.crc)
+                break;
+            index[key] = Entry{pos, h.compressed_size, h.raw_size, h.crc, 0};
+            pos = end;
+        }
+        data_end = pos;
+    }
+
+    void write_index()
+    {
+        std::vector<char> buf;
+        for (const auto &kv : index)
+        {
+            uint32_t key_size = static_cast<uint32_t>(kv.first.size());
+            const char *k = reinterpret_cast<const char *>(&key_size);
+            buf.insert(buf.end(), k, k + sizeof(key_size));
+            buf.insert(buf.end(), kv.first.begin(), kv.first.end());
+            const char *e = reinterpret_cast<const char *>(&kv.second);
+            buf.insert(buf.end(), e, e + sizeof(Entry));
+        }
+
+        Footer footer;
+        std::memset(&footer, 0, sizeof(footer));
+        footer.index_offset = data_end;
+        footer.index_size = buf.size();
+        footer.index_crc = crc(buf.data(), buf.size());
+        footer.count = static_cast<uint32_t>(index.size());
+        std::memcpy(footer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+
+        write_exact(buf.data(), buf.size(), data_end);
+        write_exact(&footer, sizeof(footer), data_end + buf.size());
+        if (ftruncate(fd, static_cast<off_t>(data_end + buf.size() + sizeof(footer))) != 0)
+            throw std::runtime_error(path + ": cannot truncate");
+    }
+
+public:
+    // writable archives are created if needed
+    explicit CampaignArchive(const std::string &filename, bool writable = false) : path(filename)
+    {
+        fd = writable ? open(filename.c_str(), O_RDWR | O_CREAT, 0644) : open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open archive " + filename);
+        refresh();
+    }
+
+    ~CampaignArchive()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    CampaignArchive(const CampaignArchive &) = delete;
+    CampaignArchive &operator=(const CampaignArchive &) = delete;
+
+    // reload the index, e.g. to see the runs appended by other processes
+    void refresh()
+    {
+        lock(F_RDLCK);
+        if (!load_index())
+            recover_index();
+        lock(F_UNLCK);
+    }
+
+    const std::map<std::string, Entry> &entries() const
+    {
+        return index;
+    }
+
+    bool contains(const std::string &key) const
+    {
+        return index.count(key) > 0;
+    }
+
+    // content of one run; only its chunk is read
+    std::string read(const std::string &key) const
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+            throw std::runtime_error(path + ": no run " + key);
+        const Entry &e = it->second;
+
+        std::vector<char> compressed(e.compressed_size);
+        if (!compressed.empty())
+            read_exact(compressed.data(), compressed.size(), e.offset + sizeof(ChunkHeader) + key.size());
+        if (crc(compressed.data(), compressed.size()) != e.crc)
+            throw std::runtime_error(path + ": corrupted run " + key);
+
+        std::string raw(e.raw_size, '\0');
+        uLongf raw_size = static_cast<uLongf>(e.raw_size);
+        if (e.raw_size > 0 &&
+            (uncompress(reinterpret_cast<Bytef *>(&raw[0]), &raw_size,
+                        reinterpret_cast<const Bytef *>(compressed.data()), compressed.size()) != Z_OK ||
+             raw_size != e.raw_size))
+            throw std::runtime_error(path + ": cannot decompress run " + key);
+        return raw;
+    }
+
+    // add (or replace) a run; safe with concurrent writers
+    void append(const std::string &key, const std::string &content)
+    {
+        uLongf compressed_size = compressBound(content.size());
+        std::vector<char> compressed(compressed_size);
+        if (compress2(reinterpret_cast<Bytef *>(compressed.data()), &compressed_size,
+                      reinterpret_cast<const Bytef *>(content.data()), content.size(), 6) != Z_OK)
+            throw std::runtime_error(path + ": cannot compress run " + key);
+        compressed.resize(compressed_size);
+
+        ChunkHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+        h.key_size = static_cast<uint32_t>(key.size());
+        h.raw_size = content.size();
+        h.compressed_size = compressed.size();
+        h.crc = crc(compressed.data(), compressed.size());
+
+        lock(F_WRLCK);
+        try
+        {
+            // other writers may have appended runs since the last refresh
+            if (!load_index())
+                recover_index();
+
+            uint64_t offset = data_end;
+            write_exact(&h, sizeof(h), offset);
+            write_exact(key.data(), key.size(), offset + sizeof(h));
+            write_exact(compressed.data(), compressed.size(), offset + sizeof(h) + key.size());
+            data_end = offset + sizeof(h) + key.size() + compressed.size();
+            index[key] = Entry{offset, h.compressed_size, h.raw_size, h.crc, 0};
+
+            write_index();
+            fsync(fd);
+        }
+        catch (...)
+        {
+            lock(F_UNLCK);
+            throw;
+        }
+        lock(F_UNLCK);
+    }
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <vector>
+#include "bimads_subproblems.hpp"
+#include "campaign.hpp"
+#include "campaign_ledger.hpp"
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*                 Smoke test of the campaign scheduler            */
+/*-----------------------------------------------------------------*/
+//
+//  1. command lines of the jobs: a default BiMADS job re-executes the
+//     campaign binary with --run-bimads, --bimads-subproblems k,
+//     --bimads-adaptive and --bimads-deterministic add their arguments (also
+//     separately), and an external solver runs its expanded command through
+//     sh;
+//  2. budgets of the rounds of the deterministic parallel BiMADS
+//     (split_round_budget);
+//  3. given a campaign binary compiled with NOMAD, one BiMADS job of ZDT1 is
+//     run end to end (default, with --bimads-subproblems 2, with
+//     --bimads-adaptive and with --bimads-subproblems 3
+//     --bimads-deterministic): the campaign must succeed, write a non-empty
+//     run and record it as done in its ledger; the deterministic job is run
+//     twice and must write the same run.
+//
+// Compile: g++ -O2 -std=c++17 -pthread campaign_check.cpp -o campaign_check -lz
+//
+// Usage: campaign_check [campaign_binary]
+//   Prints one line per check and returns EXIT_FAILURE if one fails.
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "ok     " : "FAILED ") << what << endl;
+    if (!ok)
+        ++failures;
+}
+
+static Job zdt1_job()
+{
+    Job job;
+    job.key.problem = "ZDT1";
+    job.key.family = 1;
+    job.key.solver = "bimads";
+    job.key.seed = 1;
+    job.n = 30;
+    job.m = 2;
+    job.nb_constraints = 1;
+    job.budget = 300;
+    job.cost = estimate_cost(job.n, job.m, job.nb_constraints, job.budget);
+    return job;
+}
+
+static void check_argv()
+{
+    Job job = zdt1_job();
+    const string out = "/tmp/ZDT1_1_bimads_1.txt";
+    const vector<string> bimads = {"./campaign", "--run-bimads", "ZDT1", "1", "1", "300", out};
+
+    check(job_argv(job, out, "", "./campaign", 0, false) == bimads, "default BiMADS job");
+
+    vector<string> expected = bimads;
+    expected.push_back("2");
+    check(job_argv(job, out, "", "./campaign", 2, false) == expected, "BiMADS job with 2 subproblems");
+    expected.push_back("adaptive");
+    check(job_argv(job, out, "", "./campaign", 2, true) == expected, "adaptive BiMADS job with 2 subproblems");
+
+    expected = bimads;
+    expected.push_back("1");
+    expected.push_back("adaptive");
+    check(job_argv(job, out, "", "./campaign", 0, true) == expected, "adaptive BiMADS job");
+
+    expected = bimads;
+    expected.push_back("3");
+    expected.push_back("deterministic");
+    check(job_argv(job, out, "", "./campaign", 3, false, true) == expected, "deterministic BiMADS job with 3 subproblems");
+    expected = bimads;
+    expected.push_back("1");
+    expected.push_back("adaptive");
+    expected.push_back("deterministic");
+    check(job_argv(job, out, "", "./campaign", 0, true, true) == expected, "adaptive deterministic BiMADS job");
+
+    vector<string> argv = job_argv(job, out, "solver {problem} {seed} {output}", "./campaign", 2, true, true);
+    check(argv == vector<string>{"/bin/sh", "-c", "solver ZDT1 1 " + out}, "external solver");
+}
+
+static void check_round_budget()
+{
+    check(split_round_budget({100, 100, 100}, 1000) == vector<int>{100, 100, 100}, "round within the budget");
+    check(split_round_budget({100, 100, 100}, 250) == vector<int>{100, 100, 50}, "last round: budget split in launch order");
+    check(split_round_budget({400, 100}, 300) == vector<int>{300}, "subproblem left with nothing dropped");
+    check(split_round_budget({0, 100}, 50) == vector<int>{1, 49}, "at least one evaluation per subproblem");
+    check(split_round_budget({100}, 0).empty(), "no round once the budget is used");
+}
+
+static string read_file(const string &filename)
+{
+    ifstream in(filename, ios::binary);
+    ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+// content of the run (empty if the job failed)
+static string check_run(const string &campaign, const string &options, const string &what)
+{
+    char tmpl[] = "/tmp/campaign_check_XXXXXX";
+    if (mkdtemp(tmpl) == nullptr)
+    {
+        check(false, what + " (no temporary directory)");
+        return "";
+    }
+    string dir = tmpl;
+    string command = "'" + campaign + "' -p ZDT1 -f 1 --seeds 1 -b 300 -j 1 -d " + dir + " " + options +
+                     " > " + dir + "/campaign.out 2>&1";
+    int status = system(command.c_str());
+    bool success = status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+    string run = "ZDT1_1_bimads_1";
+    string content = read_file(dir + "/" + run + ".txt");
+    bool done = CampaignLedger(dir + "/campaign.ledger").is_done(run, content);
+    check(success && !content.empty() && done, what);
+    if (!success || content.empty() || !done)
+        cout << "        see " << dir << "/campaign.out and " << dir << "/" << run << ".log" << endl;
+    else
+        system(("rm -rf " + dir).c_str());
+    return (success && done) ? content : "";
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 2)
+    {
+        cerr << "Usage: campaign_check [campaign_binary]" << endl;
+        return EXIT_FAILURE;
+    }
+    try
+    {
+        check_argv();
+        check_round_budget();
+        if (argc == 2)
+        {
+            check_run(argv[1], "", "BiMADS job run end to end");
+            check_run(argv[1], "--bimads-subproblems 2", "BiMADS job with 2 subproblems run end to end");
+            check_run(argv[1], "--bimads-adaptive", "adaptive BiMADS job run end to end");
+            const string deterministic = "--bimads-subproblems 3 --bimads-deterministic";
+            string first = check_run(argv[1], deterministic, "deterministic BiMADS job run end to end");
+            string second = check_run(argv[1], deterministic, "deterministic BiMADS job run again");
+            check(!first.empty() && first == second, "deterministic BiMADS job: same run twice");
+        }
+        else
+            cout << "(no campaign binary given: the end-to-end runs are skipped)" << endl;
+    }
+    catch (const exception &e)
+    {
+        cerr << "\ncampaign_check has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,161 @@
+#ifndef CAMPAIGN_LEDGER_HPP
+#define CAMPAIGN_LEDGER_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <zlib.h>
+
+/*-----------------------------------------------------------------*/
+/*        Append-only ledger of the jobs of a campaign             */
+/*-----------------------------------------------------------------*/
+//
+// One line per event, flushed to disk before the campaign goes on:
+//
+//   start <run>
+//   done <run> <bytes> <crc32> <seconds> <max_rss_kb>
+//   failed <run> <status>
+//
+// The last line of a run wins. On restart, a run is complete if its last
+// line is "done" and its output still has the recorded size and crc32; all
+// other runs (never started, started but interrupted by a crash, failed, or
+// whose output was lost) are run again. A line cut by a crash has no '\n'
+// and is ignored.
+//
+// Link with -lz.
+
+class CampaignLedger
+{
+public:
+    struct Record
+    {
+        std::string state; // start, done or failed
+        uint64_t bytes = 0;
+        uint32_t crc = 0;
+        double seconds = 0;
+        long max_rss_kb = 0;
+    };
+
+private:
+    std::string path;
+    int fd = -1;
+    std::map<std::string, Record> records;
+    std::mutex mtx;
+
+    void load()
+    {
+        FILE *in = std::fopen(path.c_str(), "r");
+        if (in == nullptr)
+            return;
+        std::string line;
+        int ch;
+        while ((ch = std::fgetc(in)) != EOF)
+        {
+            if (ch != '\n')
+            {
+                line += static_cast<char>(ch);
+                continue;
+            }
+            std::istringstream row(line);
+            std::string state, run;
+            Record r;
+            if (row >> state >> run)
+            {
+                r.state = state;
+                if (state == "done")
+                    row >> r.bytes >> std::hex >> r.crc >> std::dec >> r.seconds >> r.max_rss_kb;
+                if (state == "start" || state == "failed" || (state == "done" && row))
+                    records[run] = r;
+            }
+            line.clear();
+        }
+        std::fclose(in);
+    }
+
+    void write_line(const std::string &line)
+    {
+        std::lock_guard<std::mutex> guard(mtx);
+        // one write per line: lines of concurrent workers never interleave
+        if (write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size()) || fsync(fd) != 0)
+            throw std::runtime_error(path + ": write error");
+    }
+
+public:
+    explicit CampaignLedger(const std::string &filename) : path(filename)
+    {
+        load();
+        fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0)
+            throw std::runtime_error("cannot open ledger " + filename);
+        // a line cut by a crash must not be glued to the next one
+        off_t size = lseek(fd, 0, SEEK_END);
+        char last = '\n';
+        if (size > 0)
+        {
+            int rd = open(filename.c_str(), O_RDONLY);
+            if (rd < 0 || pread(rd, &last, 1, size - 1) != 1)
+                last = '\n';
+            if (rd >= 0)
+                close(rd);
+        }
+        if (last != '\n')
+            write_line("\n");
+    }
+
+    ~CampaignLedger()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    CampaignLedger(const CampaignLedger &) = delete;
+    CampaignLedger &operator=(const CampaignLedger &) = delete;
+
+    static uint32_t checksum(const std::string &content)
+    {
+        return static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef *>(content.data()),
+                                           static_cast<uInt>(content.size())));
+    }
+
+    // last record of each run found when the ledger was opened
+    const std::map<std::string, Record> &previous() const
+    {
+        return records;
+    }
+
+    // true if run was done with exactly this output
+    bool is_done(const std::string &run, const std::string &content) const
+    {
+        auto it = records.find(run);
+        return it != records.end() && it->second.state == "done" &&
+               it->second.bytes == content.size() && it->second.crc == checksum(content);
+    }
+
+    void start(const std::string &run)
+    {
+        write_line("start " + run + "\n");
+    }
+
+    void done(const std::string &run, const std::string &content, double seconds, long max_rss_kb)
+    {
+        char crc[16];
+        std::snprintf(crc, sizeof(crc), "%08x", checksum(content));
+        std::ostringstream line;
+        line << "done " << run << " " << content.size() << " " << crc << " " << seconds << " "
+             << max_rss_kb << "\n";
+        write_line(line.str());
+    }
+
+    void failed(const std::string &run, int status)
+    {
+        write_line("failed " + run + " " + std::to_string(status) + "\n");
+    }
+};
+
+#endif
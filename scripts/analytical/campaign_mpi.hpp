@@ -0,0 +1,165 @@
+#ifndef CAMPAIGN_MPI_HPP
+#define CAMPAIGN_MPI_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <mpi.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "campaign.hpp"
+
+/*-----------------------------------------------------------------*/
+/*           MPI distribution of the jobs of a campaign            */
+/*-----------------------------------------------------------------*/
+//
+// Rank 0 is the dispatcher: it owns the job queues, the ledger and the
+// outputs. Every other rank is one job slot: it asks for a job, runs it
+// locally, sends back its result with the content of its output, and asks
+// again. Queues are the same as with threads (rank r is worker r - 1, and
+// an idle rank steals from the others), so a single machine (mpirun -np 5
+// for 4 slots) and a cluster run the same code. Binding ranks to cores is
+// left to mpirun (--bind-to core).
+//
+// Only the main thread of each rank calls MPI.
+
+const int TAG_REQUEST = 1; // worker -> dispatcher: give me a job
+const int TAG_JOB = 2;     // dispatcher -> worker: "k run n m nb_constraints budget"
+const int TAG_STOP = 3;    // dispatcher -> worker: no job left
+const int TAG_RESULT = 4;  // worker -> dispatcher: ResultHeader + output
+
+struct ResultHeader
+{
+    int64_t job;
+    int64_t max_rss_kb;
+    double seconds;
+    int32_t status;
+    int32_t has_output;
+};
+
+inline std::string receive_bytes(int source, int tag, MPI_Status &status)
+{
+    MPI_Probe(source, tag, MPI_COMM_WORLD, &status);
+    int size;
+    MPI_Get_count(&status, MPI_BYTE, &size);
+    std::string buf(size, '\0');
+    MPI_Recv(size > 0 ? &buf[0] : nullptr, size, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG,
+             MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    return buf;
+}
+
+// Dispatcher (rank 0). start(k) is called when job k is sent, store(k,
+// output) when its output is received, done(k, result) after each job.
+template <class Start, class Store, class Callback>
+std::vector<JobResult> mpi_dispatch(const std::vector<Job> &jobs, Start start, Store store, Callback done)
+{
+    int nranks;
+    MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+    if (nranks < 2)
+        throw std::runtime_error("the MPI mode needs at least 2 ranks");
+
+    WorkStealingQueues queues(jobs, nranks - 1);
+    std::vector<JobResult> results(jobs.size());
+    std::vector<bool> stolen(jobs.size(), false);
+    int active = nranks - 1;
+
+    while (active > 0)
+    {
+        MPI_Status status;
+        std::string msg = receive_bytes(MPI_ANY_SOURCE, MPI_ANY_TAG, status);
+        int worker = status.MPI_SOURCE - 1;
+
+        if (status.MPI_TAG == TAG_REQUEST)
+        {
+            size_t k;
+            bool from_other;
+            if (queues.pop(worker, k, from_other))
+            {
+                stolen[k] = from_other;
+                start(k);
+                std::ostringstream job;
+                job << k << " " << jobs[k].key.to_string() << " " << jobs[k].n << " " << jobs[k].m << " "
+                    << jobs[k].nb_constraints << " " << jobs[k].budget;
+                std::string s = job.str();
+                MPI_Send(s.data(), static_cast<int>(s.size()), MPI_BYTE, status.MPI_SOURCE, TAG_JOB,
+                         MPI_COMM_WORLD);
+            }
+            else
+            {
+                MPI_Send(nullptr, 0, MPI_BYTE, status.MPI_SOURCE, TAG_STOP, MPI_COMM_WORLD);
+                --active;
+            }
+        }
+        else if (status.MPI_TAG == TAG_RESULT)
+        {
+            if (msg.size() < sizeof(ResultHeader))
+                throw std::runtime_error("truncated result from rank " + std::to_string(status.MPI_SOURCE));
+            ResultHeader h;
+            std::memcpy(&h, msg.data(), sizeof(h));
+            size_t k = static_cast<size_t>(h.job);
+            if (h.has_output)
+                store(k, msg.substr(sizeof(h)));
+
+            JobResult &res = results[k];
+            res.run = true;
+            res.status = h.status;
+            res.seconds = h.seconds;
+            res.max_rss_kb = static_cast<long>(h.max_rss_kb);
+            res.worker = worker;
+            res.stolen = stolen[k];
+            done(k, res);
+        }
+    }
+    return results;
+}
+
+// Worker (rank > 0). run(job, output, has_output) runs one job and returns
+// its JobResult; has_output tells if output holds the content of its output
+// file.
+template <class Runner>
+void mpi_serve(Runner run)
+{
+    while (true)
+    {
+        MPI_Send(nullptr, 0, MPI_BYTE, 0, TAG_REQUEST, MPI_COMM_WORLD);
+        MPI_Status status;
+        std::string msg = receive_bytes(0, MPI_ANY_TAG, status);
+        if (status.MPI_TAG == TAG_STOP)
+            return;
+
+        std::istringstream in(msg);
+        int64_t k;
+        std::string run_name;
+        Job job;
+        in >> k >> run_name >> job.n >> job.m >> job.nb_constraints >> job.budget;
+        job.key = RunKey::parse(run_name);
+        job.cost = 0;
+
+        std::string output;
+        bool has_output = false;
+        JobResult res;
+        try
+        {
+            res = run(job, output, has_output);
+        }
+        catch (std::exception &e)
+        {
+            std::cerr << run_name << ": " << e.what() << std::endl;
+            res.status = -1;
+        }
+
+        ResultHeader h;
+        std::memset(&h, 0, sizeof(h));
+        h.job = k;
+        h.max_rss_kb = res.max_rss_kb;
+        h.seconds = res.seconds;
+        h.status = res.status;
+        h.has_output = has_output;
+        std::string buf(reinterpret_cast<const char *>(&h), sizeof(h));
+        if (has_output)
+            buf += output;
+        MPI_Send(buf.data(), static_cast<int>(buf.size()), MPI_BYTE, 0, TAG_RESULT, MPI_COMM_WORLD);
+    }
+}
+
+#endif
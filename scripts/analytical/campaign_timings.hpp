@@ -0,0 +1,176 @@
+#ifndef CAMPAIGN_TIMINGS_HPP
+#define CAMPAIGN_TIMINGS_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+#include "campaign.hpp"
+
+/*-----------------------------------------------------------------*/
+/*          Durations of the jobs of previous campaigns            */
+/*-----------------------------------------------------------------*/
+//
+// Append-only file, shared by all the campaigns that use it, with one line
+// per successful job:
+//
+//   <problem> <family> <solver> <variant> <n> <m> <budget> <seconds>
+//
+// (variant "-" when empty). The duration of a job is predicted from the
+// seconds per evaluation of, in this order:
+//  1. the previous jobs of the same (problem, family, solver, variant);
+//  2. the previous jobs of the same (problem, solver);
+//  3. the cost model of campaign.hpp, scaled by the seconds per cost unit of
+//     all the previous jobs of the solver, else of all the previous jobs.
+// Without any previous job, predictions are in cost units.
+
+class TimingModel
+{
+    struct Stat
+    {
+        double seconds = 0; // sum of the durations
+        double evals = 0;   // sum of the budgets
+        double cost = 0;    // sum of the cost model
+        long count = 0;
+
+        void add(double s, double budget, double c)
+        {
+            seconds += s;
+            evals += budget;
+            cost += c;
+            ++count;
+        }
+    };
+
+    std::string path;
+    int fd = -1;
+    std::map<std::tuple<std::string, int, std::string, std::string>, Stat> by_run;
+    std::map<std::pair<std::string, std::string>, Stat> by_problem;
+    std::map<std::string, Stat> by_solver;
+    Stat all;
+    std::mutex mtx;
+
+    static std::string variant_field(const std::string &variant)
+    {
+        return variant.empty() ? "-" : variant;
+    }
+
+    void add(const std::string &problem, int family, const std::string &solver, const std::string &variant,
+             int n, int m, int budget, double seconds)
+    {
+        double c = estimate_cost(n, m, bbproblems::nb_constraints(family, n), budget);
+        by_run[std::make_tuple(problem, family, solver, variant)].add(seconds, budget, c);
+        by_problem[std::make_pair(problem, solver)].add(seconds, budget, c);
+        by_solver[solver].add(seconds, budget, c);
+        all.add(seconds, budget, c);
+    }
+
+public:
+    explicit TimingModel(const std::string &filename) : path(filename)
+    {
+        if (FILE *in = std::fopen(filename.c_str(), "r"))
+        {
+            char buf[1024];
+            while (std::fgets(buf, sizeof(buf), in))
+            {
+                std::string line = buf;
+                if (line.empty() || line.back() != '\n')
+                    continue; // cut by a crash
+                std::istringstream row(line);
+                std::string problem, solver, variant;
+                int family, n, m, budget;
+                double seconds;
+                if (row >> problem >> family >> solver >> variant >> n >> m >> budget >> seconds && budget > 0)
+                    add(problem, family, solver, variant == "-" ? "" : variant, n, m, budget, seconds);
+            }
+            std::fclose(in);
+        }
+    }
+
+    ~TimingModel()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    TimingModel(const TimingModel &) = delete;
+    TimingModel &operator=(const TimingModel &) = delete;
+
+    // true if no job was ever recorded: predictions are in cost units
+    bool empty() const
+    {
+        return all.count == 0;
+    }
+
+    // predicted duration of job in seconds; level is 1, 2 or 3 as above, or
+    // 0 for the bare cost model
+    double predict(const Job &job, int &level) const
+    {
+        auto run = by_run.find(std::make_tuple(job.key.problem, job.key.family, job.key.solver, job.key.variant));
+        if (run != by_run.end())
+        {
+            level = 1;
+            return run->second.seconds / run->second.evals * job.budget;
+        }
+        auto problem = by_problem.find(std::make_pair(job.key.problem, job.key.solver));
+        if (problem != by_problem.end())
+        {
+            level = 2;
+            return problem->second.seconds / problem->second.evals * job.budget;
+        }
+        double c = estimate_cost(job.n, job.m, job.nb_constraints, job.budget);
+        auto solver = by_solver.find(job.key.solver);
+        const Stat &s = (solver != by_solver.end()) ? solver->second : all;
+        level = (s.count > 0) ? 3 : 0;
+        return (s.count > 0) ? s.seconds / s.cost * c : c;
+    }
+
+    // appends a successful job (one write per line, as the ledger); the file
+    // is created by the first one
+    void record(const Job &job, double seconds)
+    {
+        std::ostringstream line;
+        line << job.key.problem << " " << job.key.family << " " << job.key.solver << " "
+             << variant_field(job.key.variant) << " " << job.n << " " << job.m << " " << job.budget << " "
+             << seconds << "\n";
+        std::string s = line.str();
+        std::lock_guard<std::mutex> guard(mtx);
+        if (fd < 0)
+            fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0)
+            throw std::runtime_error("cannot open timings " + path);
+        if (write(fd, s.data(), s.size()) != static_cast<ssize_t>(s.size()))
+            throw std::runtime_error(path + ": write error");
+    }
+};
+
+// Makespan of the jobs on nworkers when each idle worker takes the next job
+// in order (list scheduling; with the jobs sorted longest-first, LPT, whose
+// makespan is at most 4/3 - 1/(3 nworkers) times the optimal one: an
+// approximation, not the minimum)
+inline double predicted_makespan(const std::vector<Job> &jobs, int nworkers)
+{
+    std::priority_queue<double, std::vector<double>, std::greater<double>> free_at;
+    for (int w = 0; w < std::max(1, nworkers); ++w)
+        free_at.push(0);
+    double makespan = 0;
+    for (const Job &job : jobs)
+    {
+        double t = free_at.top() + job.cost;
+        free_at.pop();
+        free_at.push(t);
+        makespan = std::max(makespan, t);
+    }
+    return makespan;
+}
+
+#endif
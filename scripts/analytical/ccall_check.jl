@@ -0,0 +1,75 @@
+# Checks the objectives of libbbproblems (bbproblems_lib.cpp), evaluated
+# through ccall by analytical_problems.jl, against the MATLAB files of
+# problems/matlab evaluated through mxcall, on L2ZDT1 (rotated), DTLZ5 and
+# WFG9, at random points of their bounds:
+#  - the objectives built by objective_function are the ccall ones, and
+#    libbbproblems is opened and its symbols looked up once for all the
+#    evaluations of a problem, as once per job (LIBRARY_LOOKUPS);
+#  - the differences relative to max(1, |f|) stay below 1e-12 (1e-9 for
+#    WFG9, whose s_decept multiplies the errors of pow by 1000, as in
+#    simd_math_check.cpp).
+# The evaluations per second of both are printed.
+#
+#   BBPROBLEMS_LIB=/path/to/libbbproblems.so julia ccall_check.jl [points]
+#
+# points: points per problem (default 1000). Returns 1 if a check fails.
+
+using Pkg
+Pkg.activate("../../../DMultiMadsPB")
+using MATLAB
+import DataStructures.SortedDict
+using DMultiMadsPB
+using Random
+
+include("analytical_problems.jl")
+
+const TOLERANCE = 1e-12
+const PROBLEMS = ["L2ZDT1", "DTLZ5", "WFG9"]
+
+failures = 0
+
+function check(ok, message)
+    global failures
+    println(ok ? "ok     " : "FAILED ", message)
+    if !ok
+        failures += 1
+    end
+end
+
+if isempty(get(ENV, "BBPROBLEMS_LIB", "")) || length(ARGS) > 1
+    println("Usage: BBPROBLEMS_LIB=/path/to/libbbproblems.so julia ccall_check.jl [points]")
+    exit(1)
+end
+nb = isempty(ARGS) ? 1000 : parse(Int, ARGS[1])
+
+# Load matlab problems
+MATLAB.mxcall(:addpath, 0, "../../problems/matlab")
+
+dict_problems = get_pb_data_infos()
+rng = MersenneTwister(1234)
+for name in PROBLEMS
+    n, m, lb, ub = dict_problems[name]
+    lookups = LIBRARY_LOOKUPS[]
+    objectives = objective_function(name, n, m)
+    check(hasfield(typeof(objectives), :eval_ptr), "$name: evaluated through ccall")
+
+    points = [lb .+ rand(rng, n) .* (ub .- lb) for k in 1:nb]
+    fc = Vector{Vector{Float64}}(undef, nb)
+    fm = Vector{Vector{Float64}}(undef, nb)
+    tc = @elapsed for k in 1:nb
+        fc[k] = objectives(points[k])
+    end
+    tm = @elapsed for k in 1:nb
+        fm[k] = vec(mxcall(Symbol(name), 1, points[k]))
+    end
+    check(LIBRARY_LOOKUPS[] == lookups + 1,
+          "$name: $(LIBRARY_LOOKUPS[] - lookups) dlopen/dlsym for $nb evaluations")
+
+    scale = (name == "WFG9") ? 1000 : 1
+    worst = maximum(maximum(abs.(fc[k] .- fm[k]) ./ (scale .* max.(1, abs.(fm[k])))) for k in 1:nb)
+    check(worst <= TOLERANCE,
+          "$name: $nb points, max difference $worst, ccall $(round(Int, nb / tc)) evals/s, " *
+          "mxcall $(round(Int, nb / tm)) evals/s")
+end
+
+exit(failures == 0 ? 0 : 1)
@@ -0,0 +1,158 @@
+#ifndef CPU_TOPOLOGY_HPP
+#define CPU_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#include <sched.h>
+#include <string>
+#include <vector>
+
+/*-----------------------------------------------------------------*/
+/*     Hardware threads, cores, sockets and NUMA nodes (Linux)     */
+/*-----------------------------------------------------------------*/
+//
+// Read from /sys/devices/system/cpu, restricted to the CPUs the process is
+// allowed to use (taskset, cgroups, batch schedulers).
+
+struct HardwareThread
+{
+    int cpu;
+    int socket;       // physical package
+    int core;         // core id, unique inside a socket
+    int node;         // NUMA node
+    int sibling_rank; // 0 for the first hardware thread of its core
+};
+
+// where a job runs; -1: anywhere
+struct Placement
+{
+    int cpu = -1;
+    int node = -1;
+    int socket = -1;
+};
+
+inline int read_sys_int(const std::string &path, int fallback)
+{
+    std::ifstream in(path);
+    int v;
+    return (in >> v) ? v : fallback;
+}
+
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+inline std::vector<int> parse_cpu_list(const std::string &list)
+{
+    std::vector<int> cpus;
+    size_t start = 0;
+    while (start < list.size())
+    {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+        std::string range = list.substr(start, end - start);
+        size_t dash = range.find('-');
+        if (!range.empty())
+        {
+            int lo = std::atoi(range.c_str());
+            int hi = (dash == std::string::npos) ? lo : std::atoi(range.c_str() + dash + 1);
+            for (int c = lo; c <= hi; ++c)
+                cpus.push_back(c);
+        }
+        start = end + 1;
+    }
+    return cpus;
+}
+
+inline std::vector<HardwareThread> hardware_threads()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return {};
+
+    std::vector<HardwareThread> threads;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+        std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        HardwareThread t;
+        t.cpu = cpu;
+        t.socket = std::max(0, read_sys_int(dir + "/topology/physical_package_id", 0));
+        t.core = read_sys_int(dir + "/topology/core_id", cpu);
+
+        std::ifstream siblings(dir + "/topology/thread_siblings_list");
+        std::string list;
+        std::getline(siblings, list);
+        std::vector<int> sibling_cpus = parse_cpu_list(list);
+        auto pos = std::find(sibling_cpus.begin(), sibling_cpus.end(), cpu);
+        t.sibling_rank = (pos == sibling_cpus.end()) ? 0 : static_cast<int>(pos - sibling_cpus.begin());
+
+        t.node = 0;
+        if (DIR *d = opendir(dir.c_str()))
+        {
+            while (struct dirent *entry = readdir(d))
+            {
+                std::string name = entry->d_name;
+                if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+                    name.find_first_not_of("0123456789", 4) == std::string::npos)
+                    t.node = std::atoi(name.c_str() + 4);
+            }
+            closedir(d);
+        }
+        threads.push_back(t);
+    }
+    return threads;
+}
+
+// CPUs given to the workers, in order: the first hardware thread of each
+// core, alternating between sockets, then the other hardware threads of the
+// cores unless SMT siblings are reserved (left idle, so that each job has
+// its core and its caches to itself).
+inline std::vector<Placement> worker_placements(const std::vector<HardwareThread> &threads,
+                                                bool reserve_siblings)
+{
+    // per (sibling rank, socket), the threads ordered by core
+    std::map<int, std::map<int, std::vector<HardwareThread>>> groups;
+    for (const HardwareThread &t : threads)
+    {
+        if (reserve_siblings && t.sibling_rank > 0)
+            continue;
+        groups[t.sibling_rank][t.socket].push_back(t);
+    }
+
+    std::vector<Placement> placements;
+    for (auto &rank : groups)
+    {
+        for (auto &socket : rank.second)
+        {
+            std::sort(socket.second.begin(), socket.second.end(),
+                      [](const HardwareThread &a, const HardwareThread &b)
+                      { return a.core < b.core || (a.core == b.core && a.cpu < b.cpu); });
+        }
+        for (size_t k = 0;; ++k)
+        {
+            bool any = false;
+            for (auto &socket : rank.second)
+            {
+                if (k < socket.second.size())
+                {
+                    const HardwareThread &t = socket.second[k];
+                    Placement p;
+                    p.cpu = t.cpu;
+                    p.node = t.node;
+                    p.socket = t.socket;
+                    placements.push_back(p);
+                    any = true;
+                }
+            }
+            if (!any)
+                break;
+        }
+    }
+    return placements;
+}
+
+#endif
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "samplers.hpp"
+#include "../../problems/cpp/batch_constraints.hpp"
+#include "../../problems/cpp/batch_problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*       Declarations of problem_dsl.hpp: values and kernels       */
+/*-----------------------------------------------------------------*/
+//
+//  1. known answers: the objectives of all_problems, i.e. the scalar kernels
+//     of the declarations of dsl_problems.inc, at two points of each
+//     problem, must have the bits of the values recorded below, those of the
+//     functions of problems.hpp that the declarations replaced (written as
+//     the eval_x of the drivers, operation by operation). The points are
+//     x_i = lb_i + t_i (ub_i - lb_i), t_i = frac(t0 + (i + 1) / phi) with
+//     t0 = 0.1 and 0.7, so wrong bounds show too. Like the drivers, compile
+//     without -march (no contraction into FMAs);
+//  2. the generated kernels of the six families of constraints against
+//     eval_constraints for n = 3, 4, 10 and 30, for each instruction set of
+//     the CPU (or the one given by --isa): differences relative to
+//     max(1, sum_j |c_j| of family 5) below 1e-13. The points per second of
+//     the generated kernels and of those of batch_constraints.hpp are
+//     printed.
+// The batched objectives of each instruction set are checked against
+// all_problems by simd_math_check.
+//
+// Compile: g++ -O3 -std=c++17 dsl_check.cpp -o dsl_check
+//   (no -march: every instruction set is compiled in and chosen at run time)
+//
+// Usage: dsl_check [-p points] [-r repeats] [--isa name]
+//   -p    : points per family (default 100000)
+//   -r    : repetitions of the timed evaluations (default 20)
+//   --isa : scalar, sse42, avx2 or avx512 (default: each one of the CPU)
+//   Prints one line per check and returns EXIT_FAILURE if one fails.
+
+const double OBJECTIVE_TOLERANCE = 1e-13;
+
+struct KnownAnswer
+{
+    const char *problem;
+    int point; // t0 = 0.1 (0) or 0.7 (1)
+    double f[2];
+};
+
+const KnownAnswer KNOWN_ANSWERS[] = {
+        {"CL1", 0, {2296.199662676162, 0.022400626877926339}},
+        {"CL1", 1, {2045.9809576613757, 0.02452463862458025}},
+        {"DPAM1", 0, {0.70495873824291799, 121.98701802857346}},
+        {"DPAM1", 1, {-0.56921458175708173, 82.992504358858668}},
+        {"FES1", 0, {5.1734703831630711, 4.1743618100916926}},
+        {"FES1", 1, {4.3608772207581188, 2.2825657425910606}},
+        {"Kursawe", 0, {-9.6027486904792791, -0.28658642027378312}},
+        {"Kursawe", 1, {-8.0394235419326172, -2.5315496377670437}},
+        {"L1ZDT4", 0, {0.51557280900008418, 157.8982435707662}},
+        {"L1ZDT4", 1, {0.10114561800016825, 410.27441755990293}},
+        {"L2ZDT1", 0, {2.4133582187422098, 17.000933781224351}},
+        {"L2ZDT1", 1, {4.8527614377204538, 6.0553587048842887}},
+        {"L2ZDT2", 0, {2.4133582187422098, 24.490138566507824}},
+        {"L2ZDT2", 1, {4.8527614377204538, 12.787801854490798}},
+        {"L2ZDT3", 0, {2.4133582187422098, 16.017607755117712}},
+        {"L2ZDT3", 1, {4.8527614377204538, 1.2208481957408783}},
+        {"L2ZDT4", 0, {2.4133582187422098, 306.23399971954501}},
+        {"L2ZDT4", 1, {4.8527614377204538, 282.36045768454289}},
+        {"L2ZDT6", 0, {1.5485568215362853, 10.281073855428074}},
+        {"L2ZDT6", 1, {0.77301368747935961, 8.9164831519892402}},
+        {"L3ZDT1", 0, {3.3838643136483655, 9.56275682466765}},
+        {"L3ZDT1", 1, {5.9326628390084304, 1.7847104245183933}},
+        {"L3ZDT2", 0, {3.3838643136483655, 16.523340271766894}},
+        {"L3ZDT2", 1, {5.9326628390084304, 5.3092582433086255}},
+        {"L3ZDT3", 0, {3.3838643136483655, 11.20557127493368}},
+        {"L3ZDT3", 1, {5.9326628390084304, 6.8589285877818291}},
+        {"L3ZDT4", 0, {3.3838643136483655, 290.6682507415739}},
+        {"L3ZDT4", 1, {5.9326628390084304, 259.27398497763835}},
+        {"L3ZDT6", 0, {1.5188494553793781, 8.8510007138635718}},
+        {"L3ZDT6", 1, {1.034805209443646, 7.9636956800755216}},
+        {"MOP2", 0, {0.99999956593128259, 0.99999999995973354}},
+        {"MOP2", 1, {0.99999999983305587, 0.99999999977134346}},
+        {"MOP4", 0, {-9.6027486904792791, 4.577163416093728}},
+        {"MOP4", 1, {-8.0394235419326172, 12.266122197068569}},
+        {"OKA2", 0, {1.3699479545790991, 2.5763259627320174}},
+        {"OKA2", 1, {-1.1433261682927358, 3.9368277637787452}},
+        {"QV1", 0, {2.0868031673190073, 2.0971989357176652}},
+        {"QV1", 1, {2.1054219329180426, 2.1388538576287388}},
+        {"SK2", 0, {23.853180152805447, -0.24528121388903038}},
+        {"SK2", 1, {290.99879815297351, -0.74376079683832008}},
+        {"TKLY1", 0, {0.74623058987490543, 4.8961058277159575}},
+        {"TKLY1", 1, {0.38623058987490544, 9.9810193457071197}},
+        {"ZDT1", 0, {0.71803398874989488, 3.5554264491634879}},
+        {"ZDT1", 1, {0.31803398874989486, 4.0595192731208893}},
+        {"ZDT2", 0, {0.71803398874989488, 5.4592053733105734}},
+        {"ZDT2", 1, {0.31803398874989486, 5.3470100539695347}},
+        {"ZDT3", 0, {0.71803398874989488, 3.9408154336647292}},
+        {"ZDT3", 1, {0.31803398874989486, 4.2302170365716014}},
+        {"ZDT4", 0, {0.71803398874989488, 155.72361254094227}},
+        {"ZDT4", 1, {0.31803398874989486, 171.38257646185437}},
+        {"ZDT6", 0, {0.98230375450551011, 8.3572236772252246}},
+        {"ZDT6", 1, {0.99985169947058528, 8.5244161804178074}}};
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "ok     " : "FAILED ") << what << endl;
+    if (!ok)
+        ++failures;
+}
+
+static string fmt(double v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3g", v);
+    return buf;
+}
+
+static void usage()
+{
+    cerr << "Usage: dsl_check [-p points] [-r repeats] [--isa name]\n";
+    exit(EXIT_FAILURE);
+}
+
+// seconds taken by repeats calls of run
+template <class Run>
+static double seconds(int repeats, Run run)
+{
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+        run();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/*----------------------------------------*/
+/*             known answers              */
+/*----------------------------------------*/
+
+static void check_known_answers()
+{
+    size_t nb = sizeof(KNOWN_ANSWERS) / sizeof(KNOWN_ANSWERS[0]);
+    for (const Problem &pb : all_problems())
+    {
+        int found = 0;
+        bool same = pb.m == 2;
+        for (size_t k = 0; k < nb && same; ++k)
+        {
+            const KnownAnswer &ka = KNOWN_ANSWERS[k];
+            if (pb.name != ka.problem)
+                continue;
+            ++found;
+            vector<double> x(pb.n), f(pb.m);
+            for (int i = 0; i < pb.n; ++i)
+            {
+                double t = fmod((ka.point == 0 ? 0.1 : 0.7) + 0.6180339887498949 * (i + 1), 1.0);
+                x[i] = pb.lb[i] + t * (pb.ub[i] - pb.lb[i]);
+            }
+            pb.objectives(x.data(), f.data());
+            same = memcmp(f.data(), ka.f, sizeof(ka.f)) == 0;
+        }
+        check(same && found == 2, pb.name + ": known answers");
+    }
+    check(all_problems().size() == nb / 2,
+          to_string(all_problems().size()) + " problems, " + to_string(nb / 2) + " with known answers");
+}
+
+/*----------------------------------------*/
+/*        families of constraints         */
+/*----------------------------------------*/
+
+static void check_family(simd::Isa isa, int family, int nb, int repeats)
+{
+    DslConstraintFunction generated = dsl_family_constraints(family, isa);
+    ConstraintKernels written = constraint_kernels(family, isa);
+    double worst = 0, dsl = 0, hand = 0, evals = 0, sink = 0;
+    for (int n : {3, 4, 10, 30})
+    {
+        int nc = nb_constraints(family, n);
+        vector<double> lb(n, -2), ub(n, 2);
+        vector<double> x(static_cast<size_t>(n) * nb), c(static_cast<size_t>(nc) * nb);
+        LatinHypercube sampler(n, 1234);
+        sampler.next_batch(nb, lb, ub, x.data(), nb);
+
+        int nb_check = nb - 1;
+        generated(n, nb_check, x.data(), nb, c.data(), nb);
+        vector<double> xk(n), ck(nc), c5(nb_constraints(5, n));
+        for (int k = 0; k < nb_check; ++k)
+        {
+            for (int i = 0; i < n; ++i)
+                xk[i] = x[static_cast<size_t>(i) * nb + k];
+            eval_constraints(family, n, xk.data(), ck.data());
+            eval_constraints(5, n, xk.data(), c5.data());
+            double scale = 1;
+            for (double v : c5)
+                scale += fabs(v);
+            for (int j = 0; j < nc; ++j)
+                worst = max(worst, fabs(c[static_cast<size_t>(j) * nb + k] - ck[j]) / scale);
+        }
+
+        dsl += seconds(repeats, [&]() {
+            generated(n, nb, x.data(), nb, c.data(), nb);
+            sink += c[0];
+        });
+        hand += seconds(repeats, [&]() {
+            written.batch(n, nb, x.data(), nb, c.data(), nb);
+            sink += c[0];
+        });
+        evals += static_cast<double>(nb) * repeats;
+    }
+
+    check(worst <= OBJECTIVE_TOLERANCE && !isnan(sink),
+          string(simd::isa_name(isa)) + " family " + to_string(family) + ": max difference " + fmt(worst) +
+              ", generated " + fmt(evals / dsl) + " points/s, written " + fmt(evals / hand) +
+              " points/s, generated / written " + fmt(hand / dsl));
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    int points = 100000, repeats = 20;
+    string isa_name;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc)
+            points = max(8, atoi(argv[++i]));
+        else if (arg == "-r" && i + 1 < argc)
+            repeats = max(1, atoi(argv[++i]));
+        else if (arg == "--isa" && i + 1 < argc)
+            isa_name = argv[++i];
+        else
+            usage();
+    }
+
+    try
+    {
+        vector<simd::Isa> isas;
+        if (!isa_name.empty())
+        {
+            simd::force_isa(simd::parse_isa(isa_name));
+            isas.push_back(simd::active_isa());
+        }
+        else
+        {
+            for (int i = 0; i < simd::NB_ISAS; ++i)
+            {
+                if (simd::cpu_supports(static_cast<simd::Isa>(i)))
+                    isas.push_back(static_cast<simd::Isa>(i));
+            }
+        }
+        cout << "isa: " << simd::isa_report() << "\n";
+        check_known_answers();
+        for (simd::Isa isa : isas)
+        {
+            for (int family = 1; family <= NB_FAMILIES; ++family)
+                check_family(isa, family, points, repeats);
+        }
+    }
+    catch (exception &e)
+    {
+        cerr << "\ndsl_check has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
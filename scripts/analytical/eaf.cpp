@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "campaign_archive.hpp"
+#include "run_files.hpp"
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*         Empirical attainment function across seeds              */
+/*-----------------------------------------------------------------*/
+//
+// Computes the k%-attainment surfaces of a set of runs of one
+// (problem, family, variant), e.g. the 11 seeds of
+// generate_analytical_dmultimads.jl. Surfaces are exact: the bi-objective
+// case is a sweep on f1, the tri-objective case sweeps f3 and calls the
+// bi-objective sweep on each slice.
+//
+// Compile: g++ -O3 -std=c++17 eaf.cpp -o eaf -lz
+//
+// Usage: eaf -m <2|3> [-n ninputs] [-p 25,50,75] [-o prefix] run_1.txt ... run_r.txt
+//   a run stored in a campaign archive is given as archive#run, e.g.
+//   campaign.dmma#L2ZDT1_1_dmultimadsPB_1234
+//   -m : number of objectives
+//   -n : number of inputs; mandatory for BiMADS history files (no header)
+//   -p : attainment levels in percent of the number of runs
+//   -o : write each surface in <prefix>_<p>.txt instead of stdout
+//
+// Each surface is written as a list of its minimal points, one per line.
+
+typedef vector<double> Vec;
+
+struct Tagged
+{
+    Vec f;
+    int run;
+};
+
+/*--------------------------------------------------*/
+/*  bi-objective sweep: minimal points of the       */
+/*  k-attained region for all k = 1 .. r            */
+/*--------------------------------------------------*/
+static vector<vector<Vec>> eaf2d(vector<Tagged> pts, int r)
+{
+    sort(pts.begin(), pts.end(), [](const Tagged &a, const Tagged &b)
+         { return a.f < b.f; });
+
+    vector<vector<Vec>> surfaces(r);
+    vector<double> best(r, INFINITY); // best f2 of each run attained so far
+    vector<double> level(r, INFINITY); // k-th smallest best, k = 1 .. r
+    vector<double> sorted_best(r);
+
+    size_t i = 0;
+    while (i < pts.size())
+    {
+        // process all points sharing the same f1
+        double x = pts[i].f[0];
+        for (; i < pts.size() && pts[i].f[0] == x; ++i)
+        {
+            best[pts[i].run] = min(best[pts[i].run], pts[i].f[1]);
+        }
+
+        sorted_best = best;
+        sort(sorted_best.begin(), sorted_best.end());
+        for (int k = 0; k < r; ++k)
+        {
+            if (sorted_best[k] < level[k])
+            {
+                level[k] = sorted_best[k];
+                surfaces[k].push_back({x, level[k]});
+            }
+        }
+    }
+    return surfaces;
+}
+
+// true if p is weakly dominated by the staircase s (sorted by increasing f1)
+static bool attained_2d(const vector<Vec> &s, const Vec &p)
+{
+    auto it = upper_bound(s.begin(), s.end(), p[0], [](double v, const Vec &q)
+                          { return v < q[0]; });
+    if (it == s.begin())
+        return false;
+    --it;
+    return (*it)[1] <= p[1];
+}
+
+/*--------------------------------------------------*/
+/*  tri-objective sweep on f3                       */
+/*--------------------------------------------------*/
+static vector<vector<Vec>> eaf3d(vector<Tagged> pts, int r)
+{
+    sort(pts.begin(), pts.end(), [](const Tagged &a, const Tagged &b)
+         { return a.f[2] < b.f[2]; });
+
+    vector<vector<Vec>> surfaces(r);
+    vector<vector<Vec>> previous(r); // 2d surfaces of the previous slice
+    vector<Tagged> slice;
+
+    size_t i = 0;
+    while (i < pts.size())
+    {
+        double z = pts[i].f[2];
+        for (; i < pts.size() && pts[i].f[2] == z; ++i)
+        {
+            slice.push_back({{pts[i].f[0], pts[i].f[1]}, pts[i].run});
+        }
+
+        // the k-attained region only grows with z: a minimal point of the
+        // current slice is a minimal point in 3d iff it was not attained
+        // at the previous slice
+        vector<vector<Vec>> current = eaf2d(slice, r);
+        for (int k = 0; k < r; ++k)
+        {
+            for (const Vec &p : current[k])
+            {
+                if (!attained_2d(previous[k], p))
+                    surfaces[k].push_back({p[0], p[1], z});
+            }
+        }
+        previous.swap(current);
+    }
+    return surfaces;
+}
+
+// a loose file, or archive#key for a run of a campaign archive
+static Run read_run_spec(const string &spec, int m, int n)
+{
+    size_t sharp = spec.rfind('#');
+    if (sharp == string::npos)
+        return read_run_file(spec, m, n);
+
+    CampaignArchive archive(spec.substr(0, sharp));
+    istringstream in(archive.read(spec.substr(sharp + 1)));
+    return read_run(in, spec, m, n);
+}
+
+static vector<double> parse_percents(const string &s)
+{
+    vector<double> res;
+    size_t start = 0;
+    while (start <= s.size())
+    {
+        size_t end = s.find(',', start);
+        if (end == string::npos)
+            end = s.size();
+        if (end > start)
+            res.push_back(stod(s.substr(start, end - start)));
+        start = end + 1;
+    }
+    return res;
+}
+
+static void usage()
+{
+    cerr << "Usage: eaf -m <2|3> [-n ninputs] [-p 25,50,75] [-o prefix] run_1.txt ... run_r.txt\n";
+    exit(EXIT_FAILURE);
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    int m = 0;
+    int n = 0;
+    vector<double> percents = {25, 50, 75};
+    string prefix;
+    vector<string> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-m" && i + 1 < argc)
+            m = atoi(argv[++i]);
+        else if (arg == "-n" && i + 1 < argc)
+            n = atoi(argv[++i]);
+        else if (arg == "-p" && i + 1 < argc)
+            percents = parse_percents(argv[++i]);
+        else if (arg == "-o" && i + 1 < argc)
+            prefix = argv[++i];
+        else if (!arg.empty() && arg[0] == '-')
+            usage();
+        else
+            files.push_back(arg);
+    }
+    if ((m != 2 && m != 3) || files.empty())
+        usage();
+
+    try
+    {
+        int r = static_cast<int>(files.size());
+        vector<Tagged> pts;
+        for (int j = 0; j < r; ++j)
+        {
+            for (const Vec &f : feasible_front(read_run_spec(files[j], m, n)))
+            {
+                pts.push_back({f, j});
+            }
+        }
+
+        vector<vector<Vec>> surfaces = (m == 2) ? eaf2d(pts, r) : eaf3d(pts, r);
+
+        for (double pct : percents)
+        {
+            int k = static_cast<int>(ceil(pct * r / 100.0 - 1e-12));
+            k = max(1, min(r, k));
+
+            ofstream file;
+            if (!prefix.empty())
+            {
+                file.open(prefix + "_" + to_string(static_cast<int>(pct)) + ".txt");
+                if (!file)
+                    throw runtime_error("cannot write surface file");
+            }
+            ostream &out = prefix.empty() ? cout : file;
+            out.precision(17);
+
+            out << "# " << pct << "% attainment surface (level " << k << "/" << r << ")\n";
+            for (const Vec &p : surfaces[k - 1])
+            {
+                for (int l = 0; l < m; ++l)
+                {
+                    out << p[l] << (l + 1 < m ? " " : "\n");
+                }
+            }
+            if (prefix.empty())
+                out << "\n\n";
+        }
+    }
+    catch (exception &e)
+    {
+        cerr << "\neaf has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
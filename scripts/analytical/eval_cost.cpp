@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../problems/cpp/problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*        Cost of one evaluation of the objectives of the suite    */
+/*-----------------------------------------------------------------*/
+//
+// Nanoseconds per evaluation of the objectives of each problem of
+// all_problems, on the same random points for all problems. For FES1 and
+// MOP2, whose terms that only depend on n are computed out of the
+// evaluations (tabulated in dsl_problems.inc), the expressions of the
+// drivers, which recompute them at each evaluation, are also timed and the
+// two must give the same bits on every point.
+//
+// Compile: g++ -O3 -std=c++17 eval_cost.cpp -o eval_cost
+//
+// Usage: eval_cost [-e evaluations] [-s seed]
+//   -e : evaluations per problem (default 200000)
+//   -s : seed of the points (default 1)
+//   Prints one line per problem and returns EXIT_FAILURE if the bits of a
+//   problem differ from its driver.
+
+static void usage()
+{
+    cerr << "Usage: eval_cost [-e evaluations] [-s seed]\n";
+    exit(EXIT_FAILURE);
+}
+
+static string fmt(double v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3g", v);
+    return buf;
+}
+
+/*----------------------------------------*/
+/*     expressions of the drivers         */
+/*----------------------------------------*/
+
+static void driver_FES1(const double *x, double *f)
+{
+    int n = 10;
+    f[0] = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        f[0] += pow(fabs(x[i] - exp(((i + 1.0) / n) * ((i + 1.0) / n)) / 3), 0.5);
+    }
+    f[1] = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        double tmp = x[i] - 0.5 * cos(10 * PI * (i + 1.0) / n) - 0.5;
+        f[1] += tmp * tmp;
+    }
+}
+
+static void driver_MOP2(const double *x, double *f)
+{
+    int n = 4;
+    double tmp_f1 = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        tmp_f1 += -(x[i] - 1 / sqrt(n)) * (x[i] - 1 / sqrt(n));
+    }
+    f[0] = 1 - exp(tmp_f1);
+    double tmp_f2 = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        tmp_f2 += -(x[i] + 1 / sqrt(n)) * (x[i] + 1 / sqrt(n));
+    }
+    f[1] = 1 - exp(tmp_f2);
+}
+
+static ObjectiveFunction driver(const string &name)
+{
+    if (name == "FES1")
+        return driver_FES1;
+    if (name == "MOP2")
+        return driver_MOP2;
+    return nullptr;
+}
+
+/*----------------------------------------*/
+/*                timings                 */
+/*----------------------------------------*/
+
+// ns per evaluation of objectives on the points (nb points of size n)
+static double time_objectives(const ObjectiveFunction &objectives, const Problem &pb, const vector<double> &points,
+                              int nb, int evals, vector<double> &f)
+{
+    double sink = 0;
+    auto start = chrono::steady_clock::now();
+    for (int e = 0; e < evals; ++e)
+    {
+        objectives(&points[static_cast<size_t>(e % nb) * pb.n], f.data());
+        sink += f[0];
+    }
+    double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (isnan(sink))
+        f[0] = sink;
+    return 1e9 * t / evals;
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    int evals = 200000;
+    unsigned long seed = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-e" && i + 1 < argc)
+            evals = max(1, atoi(argv[++i]));
+        else if (arg == "-s" && i + 1 < argc)
+            seed = strtoul(argv[++i], nullptr, 10);
+        else
+            usage();
+    }
+
+    int failures = 0;
+    try
+    {
+        const int nb = 1024;
+        for (const Problem &pb : all_problems())
+        {
+            mt19937_64 gen(seed);
+            vector<double> points(static_cast<size_t>(nb) * pb.n);
+            for (int k = 0; k < nb; ++k)
+            {
+                for (int i = 0; i < pb.n; ++i)
+                    points[static_cast<size_t>(k) * pb.n + i] =
+                        uniform_real_distribution<double>(pb.lb[i], pb.ub[i])(gen);
+            }
+
+            vector<double> f(pb.m), fd(pb.m);
+            double cost = time_objectives(pb.objectives, pb, points, nb, evals, f);
+            char line[64];
+            snprintf(line, sizeof(line), "%-8s %8.1f ns/eval", pb.name.c_str(), cost);
+
+            ObjectiveFunction reference = driver(pb.name);
+            if (!reference)
+            {
+                cout << "       " << line << endl;
+                continue;
+            }
+            bool same = true;
+            for (int k = 0; k < nb; ++k)
+            {
+                const double *x = &points[static_cast<size_t>(k) * pb.n];
+                pb.objectives(x, f.data());
+                reference(x, fd.data());
+                same = same && memcmp(f.data(), fd.data(), pb.m * sizeof(double)) == 0;
+            }
+            double before = time_objectives(reference, pb, points, nb, evals, fd);
+            cout << (same ? "ok     " : "FAILED ") << line << ", driver " << fmt(before) << " ns/eval, speedup "
+                 << fmt(before / cost) << (same ? ", same bits" : ", bits differ") << endl;
+            failures += !same;
+        }
+    }
+    catch (exception &e)
+    {
+        cerr << "\neval_cost has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
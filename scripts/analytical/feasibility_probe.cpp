@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rng_streams.hpp"
+#include "samplers.hpp"
+#include "violation_search.hpp"
+#include "../../problems/cpp/batch_constraints.hpp"
+#include "../../problems/cpp/problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*   Feasibility probe: regenerates problems/list_of_feasible_pbs  */
+/*-----------------------------------------------------------------*/
+//
+// For each (problem, family), samples the bounds with a Sobol sequence or
+// Latin hypercubes and evaluates the constraints by batches of points with
+// eval_violations_batch. When no sampled point is feasible, a compass
+// search minimizes h = sum_j max(0, c_j)^2 from the best samples (20000
+// evaluations by default: without it, 1e6 samples miss pairs such as ZDT1_1,
+// L2ZDT1_1 or ZDT4_3).
+// Pairs are distributed over threads.
+//
+// Only the problems of problems/cpp are probed; with --update, the entries of
+// the other problems (DTLZ, WFG...) are kept from the existing list, and so
+// are the probed pairs where no feasible point was found (they are reported).
+//
+// Compile: g++ -O3 -std=c++17 -pthread feasibility_probe.cpp -o feasibility_probe
+//
+// Usage: feasibility_probe [-p problem] [-f family] [-s samples] [--sampler sobol|lhs]
+//                          [--minimize evals] [-t threads] [--stats file]
+//                          [--update list] [-o list] [--isa name]
+//   -p : one problem, by any name of find_problem, e.g. DTLZ2 or
+//        L2ZDT4-n1000-s1 (default: the problems of all_problems())
+//   --minimize : evaluations of the violation minimization (default 20000,
+//                0 to skip it)
+//   --update : merge the results into an existing list (written back in place
+//              unless -o is given)
+//   --stats  : write "pair n nb_constraints samples feasible_fraction min_h minimized"
+//   --isa    : instruction set of the kernels (scalar, sse42, avx2 or avx512;
+//              default: the widest of the CPU), logged first
+
+const int BATCH = 4096;
+const int NB_STARTS = 4; // starting points of the violation minimization
+
+struct ProbeSettings
+{
+    uint64_t samples = 1 << 22;
+    bool sobol = true;
+    int minimize_evals = 20000;
+    uint64_t seed = 1234;
+};
+
+struct ProbeResult
+{
+    const Problem *pb = nullptr;
+    int family = 0;
+    uint64_t samples = 0;
+    uint64_t feasible = 0;
+    double min_h = INFINITY;
+    bool minimized = false; // feasibility found by the minimization phase
+    double seconds = 0;
+};
+
+/*----------------------------------------*/
+/*                 probe                  */
+/*----------------------------------------*/
+template <class Sampler>
+static void sample_pair(Sampler &sampler, const Problem &pb, int family, const ProbeSettings &s,
+                        ProbeResult &res, vector<pair<double, vector<double>>> &best)
+{
+    PointBatch x(pb.n, BATCH);
+    vector<double> h;
+    vector<int> nviol;
+
+    for (uint64_t done = 0; done < s.samples; done += BATCH)
+    {
+        int nb = static_cast<int>(min<uint64_t>(BATCH, s.samples - done));
+        x.resize(nb);
+        sampler.next_batch(nb, pb.lb, pb.ub, x.data(), x.ld());
+        eval_violations_batch(family, x, h, nviol);
+
+        for (int k = 0; k < nb; ++k)
+        {
+            res.feasible += (nviol[k] == 0);
+            double hk = (nviol[k] == 0) ? 0 : h[k];
+            res.min_h = min(res.min_h, hk);
+
+            // keep the NB_STARTS least violated points
+            if (static_cast<int>(best.size()) < NB_STARTS || hk < best.back().first)
+            {
+                vector<double> xk(pb.n);
+                for (int i = 0; i < pb.n; ++i)
+                    xk[i] = x(i, k);
+                if (static_cast<int>(best.size()) == NB_STARTS)
+                    best.pop_back();
+                best.insert(upper_bound(best.begin(), best.end(), hk,
+                                        [](double v, const pair<double, vector<double>> &b)
+                                        { return v < b.first; }),
+                            {hk, xk});
+            }
+        }
+        res.samples += nb;
+    }
+}
+
+static ProbeResult probe(const Problem &pb, int family, const ProbeSettings &s)
+{
+    auto start = chrono::steady_clock::now();
+
+    ProbeResult res;
+    res.pb = &pb;
+    res.family = family;
+
+    // the same points on every platform and standard library
+    uint64_t seed = (s.seed << 32) ^ stream_id(pb.name, static_cast<uint32_t>(family));
+    vector<pair<double, vector<double>>> best;
+    if (s.sobol)
+    {
+        Sobol sampler(pb.n, seed);
+        sample_pair(sampler, pb, family, s, res, best);
+    }
+    else
+    {
+        LatinHypercube sampler(pb.n, seed);
+        sample_pair(sampler, pb, family, s, res, best);
+    }
+
+    if (res.feasible == 0 && s.minimize_evals > 0)
+    {
+        for (const auto &b : best)
+        {
+            vector<double> x = b.second;
+            double h = minimize_violation(pb, family, x, s.minimize_evals / NB_STARTS);
+            res.min_h = min(res.min_h, h);
+            if (h == 0)
+            {
+                res.minimized = true;
+                break;
+            }
+        }
+    }
+
+    res.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+/*----------------------------------------*/
+/*           list of feasible pbs         */
+/*----------------------------------------*/
+
+// "CL1_1" -> ("CL1", 1)
+static pair<string, int> parse_pair(const string &entry)
+{
+    size_t pos = entry.rfind('_');
+    if (pos == string::npos)
+        throw runtime_error("invalid entry " + entry);
+    return {entry.substr(0, pos), atoi(entry.c_str() + pos + 1)};
+}
+
+static void write_list(const string &update, const string &output, const vector<ProbeResult> &results)
+{
+    set<pair<string, int>> entries;
+    if (!update.empty())
+    {
+        ifstream in(update);
+        if (!in)
+            throw runtime_error("cannot open " + update);
+        string line;
+        while (in >> line)
+        {
+            entries.insert(parse_pair(line));
+        }
+    }
+
+    // finding no feasible point does not prove infeasibility: the entries of
+    // the existing list are kept and reported
+    for (const ProbeResult &r : results)
+    {
+        pair<string, int> key(r.pb->name, r.family);
+        if (r.feasible > 0 || r.minimized)
+            entries.insert(key);
+        else if (entries.count(key) > 0)
+            cerr << "warning: " << key.first << "_" << key.second
+                 << " kept in the list, but no feasible point was found" << endl;
+    }
+
+    string path = output.empty() ? update : output;
+    ofstream file;
+    if (!path.empty())
+    {
+        file.open(path);
+        if (!file)
+            throw runtime_error("cannot write " + path);
+    }
+    ostream &out = path.empty() ? cout : file;
+    for (const auto &e : entries)
+    {
+        out << e.first << "_" << e.second << "\n";
+    }
+}
+
+static void usage()
+{
+    cerr << "Usage: feasibility_probe [-p problem] [-f family] [-s samples] [--sampler sobol|lhs]\n"
+            "                         [--minimize evals] [-t threads] [--stats file]\n"
+            "                         [--update list] [-o list] [--isa name]\n";
+    exit(EXIT_FAILURE);
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    ProbeSettings s;
+    string name;
+    int family = 0;
+    int nthreads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    string stats, update, output, isa;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc)
+            name = argv[++i];
+        else if (arg == "-f" && i + 1 < argc)
+            family = atoi(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc)
+            s.samples = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--sampler" && i + 1 < argc)
+        {
+            string kind = argv[++i];
+            if (kind != "sobol" && kind != "lhs")
+                usage();
+            s.sobol = (kind == "sobol");
+        }
+        else if (arg == "--minimize" && i + 1 < argc)
+            s.minimize_evals = atoi(argv[++i]);
+        else if (arg == "-t" && i + 1 < argc)
+            nthreads = max(1, atoi(argv[++i]));
+        else if (arg == "--stats" && i + 1 < argc)
+            stats = argv[++i];
+        else if (arg == "--update" && i + 1 < argc)
+            update = argv[++i];
+        else if (arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if (arg == "--isa" && i + 1 < argc)
+            isa = argv[++i];
+        else
+            usage();
+    }
+    if (family < 0 || family > NB_FAMILIES)
+        usage();
+
+    try
+    {
+        // the problem of -p, any name known by find_problem (DTLZ, WFG and
+        // scalable variants too), or all the problems of the drivers
+        vector<const Problem *> problems;
+        if (name.empty())
+        {
+            for (const Problem &pb : all_problems())
+                problems.push_back(&pb);
+        }
+        else if (find_problem(name) != nullptr)
+            problems.push_back(find_problem(name));
+        else
+            throw runtime_error("unknown problem " + name);
+        if (!isa.empty())
+            simd::force_isa(simd::parse_isa(isa));
+        cerr << "isa: " << simd::isa_report() << endl;
+
+        vector<ProbeResult> results;
+        for (const Problem *pb : problems)
+        {
+            for (int fam = 1; fam <= NB_FAMILIES; ++fam)
+            {
+                if (family == 0 || fam == family)
+                {
+                    results.push_back(ProbeResult());
+                    results.back().pb = pb;
+                    results.back().family = fam;
+                }
+            }
+        }
+
+        // one pair at a time per thread
+        atomic<size_t> next(0);
+        vector<thread> pool;
+        for (int t = 0; t < nthreads; ++t)
+        {
+            pool.emplace_back([&]()
+                              {
+                for (size_t k = next++; k < results.size(); k = next++)
+                    results[k] = probe(*results[k].pb, results[k].family, s); });
+        }
+        for (thread &th : pool)
+        {
+            th.join();
+        }
+
+        for (const ProbeResult &r : results)
+        {
+            cerr << r.pb->name << "_" << r.family << ": " << r.feasible << "/" << r.samples
+                 << " feasible, min h = " << r.min_h << (r.minimized ? " (minimization)" : "")
+                 << ", " << r.seconds << " s" << endl;
+        }
+
+        if (!stats.empty())
+        {
+            ofstream out(stats);
+            if (!out)
+                throw runtime_error("cannot write " + stats);
+            out.precision(10);
+            out << "# pair n nb_constraints samples feasible_fraction min_h minimized\n";
+            for (const ProbeResult &r : results)
+            {
+                out << r.pb->name << "_" << r.family << " " << r.pb->n << " "
+                    << nb_constraints(r.family, r.pb->n) << " " << r.samples << " "
+                    << static_cast<double>(r.feasible) / r.samples << " " << r.min_h << " "
+                    << r.minimized << "\n";
+            }
+        }
+
+        write_list(update, output, results);
+    }
+    catch (exception &e)
+    {
+        cerr << "\nfeasibility_probe has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,494 @@
+#ifndef PARALLEL_BIMADS_HPP
+#define PARALLEL_BIMADS_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "nomad.hpp"
+#include "bimads_subproblems.hpp"
+#include "rng_streams.hpp"
+#include "shared_eval_cache.hpp"
+
+/*-----------------------------------------------------------------*/
+/*    BiMADS with concurrent subproblems (NOMAD 3, processes)      */
+/*-----------------------------------------------------------------*/
+//
+// The subproblems of BiMADS (see bimads_subproblems.hpp) are solved by
+// single-objective Mads runs in child processes, up to nb_parallel at a
+// time: both anchors first, then, once they are done, one reference point
+// per free slot, chosen from the front of all the evaluations so far. NOMAD 3
+// keeps global state (RNG, tags, force_quit), so two Mads instances cannot
+// share a process; the children share instead an evaluation cache and the
+// evaluation budget in shared memory (shared_eval_cache.hpp). A point known
+// by the cache is not evaluated again nor counted, whatever subproblem found
+// it first.
+//
+// With nb_parallel = 1 the subproblems are solved one after another, as by
+// Mads::multi_run, and a run is reproducible. With nb_parallel > 1 only the
+// NOMAD seed of each subproblem is fixed (subproblem_seed): the reference
+// points depend on the front when a slot frees up, and which subproblem
+// evaluates a point first and spends the last evaluations of the budget
+// depend on scheduling, so two runs may differ. Each subproblem gets at most
+// budget / nb_runs evaluations (nb_runs = 30, like MULTI_NB_MADS_RUNS in the
+// drivers); subproblems are started until the whole budget is used.
+//
+// With deterministic = true, the subproblems run in rounds of nb_parallel
+// (the anchors first), and a run only depends on the seed and nb_parallel:
+//  - the reference points of a round are all chosen from the front at its
+//    start;
+//  - the budgets of the round are split before it starts, in launch order
+//    (split_round_budget), so no subproblem races for the last evaluations;
+//  - during the round, the shared cache is only read: each subproblem keeps
+//    its new evaluations in its own cache, and they are inserted in the
+//    shared cache at the end of the round, in launch order. A point found by
+//    two subproblems of a round is evaluated and counted twice.
+// A round waits for its slowest subproblem, so the cores are less busy.
+//
+// With adaptive = true, reference points are chosen by the hypervolume their
+// subproblem can add and get budgets in proportion (AdaptiveBudget), instead
+// of the distance gaps and fixed budgets of NOMAD. The scaled hypervolume of
+// the front and the gain per evaluation of each subproblem are printed in
+// both modes. The gain of a subproblem is its own: each child tags the
+// entries it inserts in the cache with its run, and when it ends, its gain
+// is the hypervolume of the front minus that of the front without its
+// points, so the points of the siblings running meanwhile are not counted.
+// In rounds, the gain is that of its points after those of the subproblems
+// launched before it in the round.
+
+// a constrained bi-objective blackbox
+struct BlackBox
+{
+    int n = 0;
+    int m = 2;  // objectives
+    int nc = 0; // constraints, treated with the progressive barrier
+    std::vector<double> lb, ub;
+    std::vector<std::vector<double>> x0;
+    std::function<void(const double *x, double *out)> eval; // m objectives then nc constraints
+};
+
+class SubproblemEvaluator : public NOMAD::Evaluator
+{
+    const BlackBox &bb;
+    const Subproblem &sp;
+    SharedEvalCache &cache;
+    SharedEvalCache *pending; // new evaluations, if the shared cache is only read
+    long *evaluations; // of this subproblem
+    long run;          // tag of its entries in the cache
+    mutable std::vector<double> x, out;
+    mutable std::string failure; // evaluation lost by the cache, the run stops
+
+public:
+    SubproblemEvaluator(const NOMAD::Parameters &p, const BlackBox &blackbox, const Subproblem &subproblem,
+                        SharedEvalCache &shared, long *counter, SharedEvalCache *own = nullptr, long tag = 0)
+        : NOMAD::Evaluator(p), bb(blackbox), sp(subproblem), cache(shared), pending(own), evaluations(counter),
+          run(tag), x(blackbox.n), out(blackbox.m + blackbox.nc)
+    {
+    }
+
+    ~SubproblemEvaluator(void) {}
+
+    const std::string &error() const
+    {
+        return failure;
+    }
+
+    bool eval_x(NOMAD::Eval_Point &point,
+                const NOMAD::Double & /*h_max*/,
+                bool &count_eval) const
+    {
+        for (int i = 0; i < bb.n; ++i)
+        {
+            x[i] = point[i].value();
+        }
+
+        count_eval = false; // a point of the shared cache is free
+        if (!cache.find(x.data(), out.data()) && (pending == nullptr || !pending->find(x.data(), out.data())))
+        {
+            SharedEvalCache &target = (pending != nullptr) ? *pending : cache;
+            if (!target.reserve_evaluation())
+            {
+                // the budget of the whole run is used
+                NOMAD::Evaluator::force_quit(0);
+                return false;
+            }
+            bb.eval(x.data(), out.data());
+            try
+            {
+                // false if another subproblem evaluated x meanwhile: it is
+                // in the cache (and the history) all the same
+                target.insert(x.data(), out.data(), run);
+            }
+            catch (std::exception &e)
+            {
+                failure = e.what();
+                NOMAD::Evaluator::force_quit(0);
+                return false;
+            }
+            ++*evaluations;
+            count_eval = true;
+        }
+
+        point.set_bb_output(0, bimads_objective(sp, out[0], out[1])); // objective
+        for (int j = 0; j < bb.nc; ++j)
+        {
+            point.set_bb_output(1 + j, out[bb.m + j]); // constraints
+        }
+
+        return true;
+    }
+};
+
+// one subproblem, in a child process, its new evaluations tagged with run;
+// with pending, they go there and cache is only read
+inline int run_subproblem(const BlackBox &bb, const Subproblem &sp, SharedEvalCache &cache, int seed,
+                          int max_bb_eval, long *evaluations, SharedEvalCache *pending = nullptr, long run = 0)
+{
+    NOMAD::Display out(std::cout);
+    out.precision(NOMAD::DISPLAY_PRECISION_STD);
+
+    try
+    {
+        NOMAD::Parameters p(out);
+
+        p.set_DIMENSION(bb.n);
+
+        std::vector<NOMAD::bb_output_type> bbot(1 + bb.nc, NOMAD::PB);
+        bbot[0] = NOMAD::OBJ;
+        p.set_BB_OUTPUT_TYPE(bbot);
+
+        NOMAD::Point lb(bb.n), ub(bb.n);
+        for (int i = 0; i < bb.n; ++i)
+        {
+            lb[i] = bb.lb[i];
+            ub[i] = bb.ub[i];
+        }
+        p.set_LOWER_BOUND(lb);
+        p.set_UPPER_BOUND(ub);
+
+        for (const std::vector<double> &x0s : sp.x0)
+        {
+            NOMAD::Point x0(bb.n);
+            for (int i = 0; i < bb.n; ++i)
+            {
+                x0[i] = x0s[i];
+            }
+            p.set_X0(x0);
+        }
+
+        p.set_DISPLAY_DEGREE(0);
+        p.set_MAX_BB_EVAL(max_bb_eval);
+        p.set_SEED(seed);
+
+        p.check();
+
+        SubproblemEvaluator ev(p, bb, sp, cache, evaluations, pending, run);
+
+        NOMAD::Mads mads(p, &ev);
+        mads.run();
+        if (!ev.error().empty())
+            throw std::runtime_error(ev.error());
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// NOMAD seed of the k-th subproblem launched, whatever nb_parallel
+inline int subproblem_seed(int seed, int k)
+{
+    RngStream rng(static_cast<uint64_t>(seed), static_cast<uint32_t>(k));
+    return static_cast<int>(rng.next_u32() >> 1);
+}
+
+// Runs BiMADS with up to nb_parallel concurrent subproblems (in rounds if
+// deterministic) and writes all its evaluations in history_file (same rows
+// as a NOMAD history file). Returns EXIT_SUCCESS or EXIT_FAILURE.
+inline int run_parallel_bimads(int argc, char **argv, const BlackBox &bb, int seed, int budget,
+                               const std::string &history_file, int nb_parallel, bool adaptive = false,
+                               bool deterministic = false, int nb_runs = 30)
+{
+    int status = EXIT_SUCCESS;
+    nb_parallel = std::max(1, nb_parallel);
+
+    try
+    {
+        if (bb.m != 2)
+            throw std::runtime_error("BiMADS needs 2 objectives");
+        NOMAD::begin(argc, argv);
+
+        SharedEvalCache cache(bb.n, bb.m + bb.nc, budget);
+        ReferencePointSelector selector;
+        AdaptiveBudget measure(budget, nb_runs);
+        int run_budget = std::max(1, budget / std::max(1, nb_runs));
+
+        // evaluations of each slot, written by its child
+        void *mem = mmap(nullptr, sizeof(long) * nb_parallel, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED)
+            throw std::runtime_error("cannot map the evaluation counters");
+        long *slot_evaluations = static_cast<long *>(mem);
+        std::vector<bool> slot_used(nb_parallel, false);
+        int launched = 0;
+
+        // front of the cache, without the points of run (if run > 0)
+        auto current_front = [&](long run = 0)
+        {
+            std::vector<RunEval> evals;
+            cache.for_each_tagged([&](const double *x, const double *out, long tag)
+                                  {
+                if (run > 0 && tag == run)
+                    return;
+                RunEval e;
+                e.x.assign(x, x + bb.n);
+                e.f.assign(out, out + bb.m);
+                e.c.assign(out + bb.m, out + bb.m + bb.nc);
+                evals.push_back(e); });
+            return pareto_front(evals);
+        };
+
+        // the next subproblem after the anchors; j receives the position of
+        // its point in front, or -1 if there is none (the anchors again)
+        auto choose = [&](const std::vector<FrontPoint> &front, Subproblem &sp, long &j)
+        {
+            if (!measure.ready())
+                measure.set_bounds(front);
+            size_t k = 0;
+            GapScore score = nullptr;
+            if (adaptive && measure.ready())
+                score = [&](const std::vector<FrontPoint> &fr, size_t i)
+                { return measure.gap_area(fr, i); };
+            j = -1;
+            if (selector.next(front, sp, score, &k))
+                j = static_cast<long>(k);
+        };
+
+        // forks the child of the subproblem launched in slot
+        auto launch = [&](const Subproblem &sp, int slot, int max_bb_eval, SharedEvalCache *pending)
+        {
+            slot_evaluations[slot] = 0;
+            std::cout.flush();
+            pid_t pid = fork();
+            if (pid < 0)
+                throw std::runtime_error("fork failed");
+            if (pid == 0)
+            {
+                int rc = run_subproblem(bb, sp, cache, subproblem_seed(seed, launched), max_bb_eval,
+                                        &slot_evaluations[slot], pending, launched + 1);
+                std::cout.flush();
+                _exit(rc);
+            }
+            ++launched;
+            return pid;
+        };
+
+        auto report = [&](int index, const Subproblem &sp, long own)
+        {
+            std::cout << "subproblem " << index + 1
+                      << (sp.anchor >= 0 ? " (anchor f" + std::to_string(sp.anchor + 1) + ")" : "")
+                      << " done, " << own << " evaluations, " << cache.evaluations() << " in all";
+        };
+
+        struct Running
+        {
+            int index;
+            int slot;
+            Subproblem sp;
+            long evaluations_at_start;
+        };
+        std::map<pid_t, Running> running;
+        int anchors_done = 0, stalled = 0;
+
+        // rounds, until the budget is used or two rounds in a row add no
+        // evaluation
+        while (deterministic && stalled < 2)
+        {
+            // a round: its subproblems, their budgets and the front they start from
+            std::vector<FrontPoint> front = current_front();
+            long remaining = budget - cache.evaluations();
+            std::vector<Subproblem> round;
+            std::vector<int> requested;
+            for (int k = 0; k < nb_parallel && remaining > 0; ++k)
+            {
+                Subproblem sp;
+                long j = -1;
+                if (launched + k < 2)
+                    sp.anchor = launched + k;
+                else if (launched < 2)
+                    break; // the front of the anchors first
+                else
+                    choose(front, sp, j);
+                if (sp.anchor >= 0 || j < 0)
+                {
+                    sp.anchor = (sp.anchor >= 0) ? sp.anchor : (launched + k) % 2;
+                    sp.x0 = bb.x0;
+                }
+                requested.push_back((adaptive && measure.ready() && j >= 0)
+                                        ? measure.run_budget(front, static_cast<size_t>(j), remaining)
+                                        : run_budget);
+                round.push_back(sp);
+            }
+            std::vector<int> budgets = split_round_budget(requested, remaining);
+            if (budgets.empty())
+                break;
+            round.resize(budgets.size());
+
+            int first = launched;
+            std::vector<std::unique_ptr<SharedEvalCache>> pending;
+            std::vector<pid_t> pids;
+            for (size_t k = 0; k < round.size(); ++k)
+            {
+                pending.emplace_back(new SharedEvalCache(bb.n, bb.m + bb.nc, budgets[k]));
+                pids.push_back(launch(round[k], static_cast<int>(k), budgets[k], pending[k].get()));
+            }
+            for (pid_t pid : pids)
+            {
+                int wstatus;
+                if (waitpid(pid, &wstatus, 0) < 0)
+                    throw std::runtime_error("waitpid failed");
+                if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
+                    status = EXIT_FAILURE;
+            }
+
+            // the evaluations of the round, in launch order
+            long evaluations_at_start = cache.evaluations();
+            for (size_t k = 0; k < round.size(); ++k)
+            {
+                double hv = measure.ready() ? measure.hypervolume(current_front()) : 0;
+                pending[k]->for_each_tagged([&](const double *x, const double *out, long tag)
+                                            {
+                    cache.reserve_evaluation();
+                    cache.insert(x, out, tag); });
+                long own = pending[k]->evaluations();
+                report(first + static_cast<int>(k), round[k], own);
+                if (measure.ready() && round[k].anchor < 0)
+                {
+                    // gain of the front by the points of this subproblem,
+                    // after those of the subproblems launched before it
+                    double hv_after = measure.hypervolume(current_front());
+                    double gain = hv_after - hv;
+                    std::cout << ", hypervolume " << hv_after << " (" << (own > 0 ? gain / own : 0)
+                              << " per evaluation)";
+                    if (measure.record(gain, own) && adaptive)
+                        selector.penalize(round[k], 2);
+                }
+                std::cout << std::endl;
+            }
+            stalled = (cache.evaluations() == evaluations_at_start) ? stalled + 1 : 0;
+        }
+
+        while (!deterministic)
+        {
+            // a run that ends with no new evaluation anywhere is stalled:
+            // the front does not move any more
+            while (static_cast<int>(running.size()) < nb_parallel && cache.evaluations() < budget &&
+                   stalled < 2 * nb_parallel)
+            {
+                Subproblem sp;
+                std::vector<FrontPoint> front;
+                if (launched < 2)
+                {
+                    sp.anchor = launched;
+                    sp.x0 = bb.x0;
+                }
+                else if (anchors_done < 2)
+                {
+                    break;
+                }
+                else
+                {
+                    front = current_front();
+                    long j;
+                    choose(front, sp, j);
+                    if (j < 0)
+                    {
+                        // no feasible point yet: the anchors again
+                        sp.anchor = launched % 2;
+                        sp.x0 = bb.x0;
+                    }
+                    else if (adaptive && measure.ready())
+                    {
+                        sp.max_bb_eval = measure.run_budget(front, static_cast<size_t>(j), budget - cache.evaluations());
+                    }
+                }
+
+                int slot = static_cast<int>(std::find(slot_used.begin(), slot_used.end(), false) - slot_used.begin());
+                slot_used[slot] = true;
+                int index = launched;
+                pid_t pid = launch(sp, slot, sp.max_bb_eval > 0 ? sp.max_bb_eval : run_budget, nullptr);
+                running[pid] = Running{index, slot, sp, cache.evaluations()};
+            }
+            if (running.empty())
+                break;
+
+            int wstatus;
+            pid_t pid = waitpid(-1, &wstatus, 0);
+            if (pid < 0)
+                throw std::runtime_error("waitpid failed");
+            auto it = running.find(pid);
+            if (it == running.end())
+                continue;
+            if (!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0)
+                status = EXIT_FAILURE;
+            const Running &run = it->second;
+            long evaluations = cache.evaluations();
+            long own = slot_evaluations[run.slot];
+            slot_used[run.slot] = false;
+            if (run.sp.anchor >= 0 && run.index < 2)
+                ++anchors_done;
+            stalled = (evaluations == run.evaluations_at_start) ? stalled + 1 : 0;
+
+            report(run.index, run.sp, own);
+            if (measure.ready() && run.sp.anchor < 0)
+            {
+                // gain of the front by the points of this subproblem only
+                double hv = measure.hypervolume(current_front());
+                double gain = hv - measure.hypervolume(current_front(run.index + 1));
+                std::cout << ", hypervolume " << hv << " (" << (own > 0 ? gain / own : 0) << " per evaluation)";
+                if (measure.record(gain, own) && adaptive)
+                    selector.penalize(run.sp, 2);
+            }
+            std::cout << std::endl;
+            running.erase(it);
+        }
+        munmap(mem, sizeof(long) * nb_parallel);
+
+        std::ofstream history(history_file);
+        if (!history)
+            throw std::runtime_error("cannot write " + history_file);
+        history << std::setprecision(std::numeric_limits<double>::max_digits10);
+        cache.for_each([&](const double *x, const double *out)
+                       {
+            for (int i = 0; i < bb.n; ++i)
+                history << x[i] << " ";
+            for (int j = 0; j < bb.m + bb.nc; ++j)
+                history << out[j] << (j + 1 < bb.m + bb.nc ? " " : "\n"); });
+        if (!history)
+            throw std::runtime_error("cannot write " + history_file);
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "\nNOMAD has been interrupted (" << e.what() << ")\n\n";
+        status = EXIT_FAILURE;
+    }
+
+    NOMAD::end();
+
+    return status;
+}
+
+#endif
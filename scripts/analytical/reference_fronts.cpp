@@ -0,0 +1,580 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rng_streams.hpp"
+#include "run_files.hpp"
+#include "violation_search.hpp"
+#include "../../problems/cpp/problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*     Reference Pareto fronts of the constrained analytical suite */
+/*-----------------------------------------------------------------*/
+//
+// For each (problem, family), the reference front is built by:
+//  1. the analytic Pareto set of the problem without constraints where it is
+//     known, restricted to its feasible part: ZDT1-4, ZDT6 (x_1 in [0, 1],
+//     x_i = 0 otherwise) and the rotated problems DPAM1, L1ZDT4, L2ZDT* and
+//     L3ZDT* (y_i = 0 for i > 1, i.e. x = M^-1 (t e_1), or x.^2 for L3ZDT,
+//     for the t keeping x in the bounds; with the matrices of the drivers,
+//     only x = 0 is in [0, 1]^n for L2ZDT and L3ZDT);
+//  2. a massive uniform sampling of the bounds;
+//  3. when no point so far is feasible, a compass search on the violation
+//     (violation_search.hpp) from the least violated samples and points of
+//     the analytic set;
+//  4. rounds of local refinement: points of the current front are perturbed
+//     in a box which is halved at each round, with the same number of
+//     perturbations per round whatever the size of the front, so that small
+//     fronts get denser.
+// Only feasible points (all constraints <= 0) are kept. Sampling and
+// refinement are split across threads; each sample and each chunk of
+// perturbations draws from its own random stream (rng_streams.hpp), keyed by
+// the seed, the (problem, family), the phase and its 64-bit index, so fronts
+// are the same for any number of threads.
+//
+// Fronts are cached in <dir>/<problem>_<family>.front and reused as long as
+// the format, the problem version, the seed and the sampling budget match.
+//
+// Compile: g++ -O3 -std=c++17 -pthread reference_fronts.cpp -o reference_fronts
+//
+// Usage: reference_fronts [-p problem] [-f family] [-s samples] [-r rounds]
+//                         [-n max_points] [-t threads] [-d dir] [--seed seed] [--text]
+//   -p     : one problem, by any name of find_problem, e.g. DTLZ2 or
+//            L2ZDT4-n1000-s1 (default: the problems of all_problems())
+//   --seed : seed of the random streams (default 1234)
+//   --text : also write the objective vectors in <dir>/<problem>_<family>_front.txt
+
+struct FrontPoint
+{
+    vector<double> x;
+    vector<double> f;
+};
+
+static const vector<double> &objectives_of(const FrontPoint &p)
+{
+    return p.f;
+}
+
+static vector<FrontPoint> filter(vector<FrontPoint> pts)
+{
+    // of the points with the same objectives, the smallest x is kept: the
+    // front does not depend on the order in which threads found them
+    sort(pts.begin(), pts.end(), [](const FrontPoint &a, const FrontPoint &b)
+         { return a.f < b.f || (a.f == b.f && a.x < b.x); });
+    return nondominated(move(pts), objectives_of);
+}
+
+struct Settings
+{
+    uint64_t samples = 1000000;
+    int rounds = 10;
+    int perturbations = 20; // per front point and per round
+    size_t max_parents = 20000; // front points perturbed at each round
+    size_t max_points = 100000; // size of the reference fronts
+    int threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    uint64_t seed = 1234;
+    int minimize_evals = 20000; // of the violation search, when no sample is feasible
+};
+
+const int NB_STARTS = 8; // starting points of the violation search
+
+/*----------------------------------------*/
+/*       binary cache of the fronts       */
+/*----------------------------------------*/
+
+static const char FRONT_MAGIC[8] = {'D', 'M', 'M', 'F', 'R', 'O', 'N', 'T'};
+// 2: counter-based streams (rng_streams.hpp) and the seed in the header
+// 3: analytic sets of the rotated problems, violation search, 64-bit draws
+static const uint32_t FRONT_FORMAT = 3;
+
+struct FrontHeader
+{
+    char magic[8];
+    uint32_t format;
+    uint32_t version; // Problem::version
+    uint32_t n;
+    uint32_t m;
+    uint32_t family;
+    uint32_t rounds;
+    uint64_t samples;
+    uint64_t max_points;
+    uint64_t count;
+    uint64_t seed;
+};
+
+static string front_path(const string &dir, const Problem &pb, int family)
+{
+    return dir + "/" + pb.name + "_" + to_string(family) + ".front";
+}
+
+static FrontHeader make_header(const Problem &pb, int family, const Settings &s, uint64_t count)
+{
+    FrontHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, FRONT_MAGIC, sizeof(FRONT_MAGIC));
+    h.format = FRONT_FORMAT;
+    h.version = pb.version;
+    h.n = pb.n;
+    h.m = pb.m;
+    h.family = family;
+    h.rounds = s.rounds;
+    h.samples = s.samples;
+    h.max_points = s.max_points;
+    h.count = count;
+    h.seed = s.seed;
+    return h;
+}
+
+// true if the cache exists and was built for the same problem version and
+// seed with at least the same budget
+static bool load_front(const string &path, const Problem &pb, int family, const Settings &s,
+                       vector<FrontPoint> &front)
+{
+    ifstream in(path, ios::binary);
+    if (!in)
+        return false;
+
+    FrontHeader h;
+    if (!in.read(reinterpret_cast<char *>(&h), sizeof(h)))
+        return false;
+    if (memcmp(h.magic, FRONT_MAGIC, sizeof(FRONT_MAGIC)) != 0 || h.format != FRONT_FORMAT ||
+        h.version != static_cast<uint32_t>(pb.version) || h.n != static_cast<uint32_t>(pb.n) ||
+        h.m != static_cast<uint32_t>(pb.m) || h.family != static_cast<uint32_t>(family) ||
+        h.seed != s.seed || h.samples < s.samples || h.rounds < static_cast<uint32_t>(s.rounds) ||
+        h.max_points < s.max_points)
+        return false;
+
+    front.assign(h.count, FrontPoint());
+    for (FrontPoint &p : front)
+    {
+        p.x.resize(pb.n);
+        p.f.resize(pb.m);
+        in.read(reinterpret_cast<char *>(p.x.data()), pb.n * sizeof(double));
+        in.read(reinterpret_cast<char *>(p.f.data()), pb.m * sizeof(double));
+    }
+    return static_cast<bool>(in);
+}
+
+static void save_front(const string &path, const Problem &pb, int family, const Settings &s,
+                       const vector<FrontPoint> &front)
+{
+    // write in a temporary file first so that an interrupted run never
+    // leaves a truncated cache
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp, ios::binary);
+        FrontHeader h = make_header(pb, family, s, front.size());
+        out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+        for (const FrontPoint &p : front)
+        {
+            out.write(reinterpret_cast<const char *>(p.x.data()), pb.n * sizeof(double));
+            out.write(reinterpret_cast<const char *>(p.f.data()), pb.m * sizeof(double));
+        }
+        if (!out)
+            throw runtime_error("cannot write " + tmp);
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0)
+        throw runtime_error("cannot rename " + tmp);
+}
+
+/*----------------------------------------*/
+/*              generation                */
+/*----------------------------------------*/
+
+// Stream of the k-th draw of a phase (0: sampling, r: round r). The high
+// half of k goes to the upper 16 bits of the iteration field, so draws
+// beyond 2^32 do not reuse the streams of the first ones.
+static RngStream draw_stream(const Settings &s, uint32_t pair, uint32_t phase, uint64_t k)
+{
+    return RngStream(s.seed, pair, phase | static_cast<uint32_t>(k >> 32) << 16, static_cast<uint32_t>(k));
+}
+
+// evaluate x and append it to pts if it is feasible; returns its violation
+// h = sum_j max(0, c_j)^2
+static double try_point(const Problem &pb, int family, vector<double> &x, vector<double> &c,
+                        vector<FrontPoint> &pts)
+{
+    eval_constraints(family, pb.n, x.data(), c.data());
+    double h = 0;
+    for (double cj : c)
+    {
+        if (!(cj <= 0))
+            h += cj * cj;
+    }
+    if (h > 0 || isnan(h))
+        return h;
+    FrontPoint p;
+    p.f.resize(pb.m);
+    pb.objectives(x.data(), p.f.data());
+    for (double fi : p.f)
+    {
+        if (!isfinite(fi))
+            return h;
+    }
+    p.x = x;
+    pts.push_back(move(p));
+    return h;
+}
+
+// filter the buffer of a thread once it has doubled since its last filtering
+static void compact(vector<FrontPoint> &pts, size_t &threshold)
+{
+    if (pts.size() < threshold)
+        return;
+    pts = filter(move(pts));
+    threshold = max(threshold, 2 * pts.size());
+}
+
+// at most nb points of the front, evenly spread in lexicographic order
+static vector<const FrontPoint *> spread(const vector<FrontPoint> &front, size_t nb)
+{
+    vector<const FrontPoint *> res;
+    size_t count = min(nb, front.size());
+    for (size_t k = 0; k < count; ++k)
+    {
+        res.push_back(&front[k * front.size() / count]);
+    }
+    return res;
+}
+
+// run work(thread_id, pts) on each thread and merge the fronts found
+template <class Work>
+static vector<FrontPoint> run_parallel(int nthreads, Work work)
+{
+    vector<vector<FrontPoint>> found(nthreads);
+    vector<thread> pool;
+    for (int t = 0; t < nthreads; ++t)
+    {
+        pool.emplace_back([&, t]()
+                          { work(t, found[t]); found[t] = filter(move(found[t])); });
+    }
+    for (thread &th : pool)
+    {
+        th.join();
+    }
+
+    vector<FrontPoint> all;
+    for (vector<FrontPoint> &f : found)
+    {
+        all.insert(all.end(), make_move_iterator(f.begin()), make_move_iterator(f.end()));
+    }
+    return filter(move(all));
+}
+
+// (violation, x) of the least violated points, in increasing order; ties are
+// broken by x so that the result does not depend on the threads
+typedef vector<pair<double, vector<double>>> Violated;
+
+static void keep_least_violated(Violated &best, double h, const vector<double> &x)
+{
+    pair<double, vector<double>> e(h, x);
+    if (static_cast<int>(best.size()) == NB_STARTS && !(e < best.back()))
+        return;
+    best.insert(upper_bound(best.begin(), best.end(), e), move(e));
+    if (static_cast<int>(best.size()) > NB_STARTS)
+        best.pop_back();
+}
+
+// v such that M v = e_1 (Gauss-Jordan with partial pivoting)
+template <int n>
+static vector<double> solve_e1(const double (*M)[n])
+{
+    vector<vector<double>> a(n, vector<double>(n + 1));
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+            a[i][j] = M[i][j];
+        a[i][n] = (i == 0);
+    }
+    for (int c = 0; c < n; ++c)
+    {
+        int p = c;
+        for (int r = c + 1; r < n; ++r)
+        {
+            if (fabs(a[r][c]) > fabs(a[p][c]))
+                p = r;
+        }
+        swap(a[c], a[p]);
+        for (int r = 0; r < n; ++r)
+        {
+            if (r == c)
+                continue;
+            double f = a[r][c] / a[c][c];
+            for (int k = c; k <= n; ++k)
+                a[r][k] -= f * a[c][k];
+        }
+    }
+    vector<double> v(n);
+    for (int i = 0; i < n; ++i)
+        v[i] = a[i][n] / a[i][i];
+    return v;
+}
+
+// Points of the Pareto set of the problem without constraints, when it is
+// known: x = t v (or x.^2 = t v if squared) for the t keeping x in the bounds
+static vector<vector<double>> line_set(const Problem &pb, const vector<double> &v, bool squared, int nb)
+{
+    double tlo = -INFINITY, thi = INFINITY;
+    for (int i = 0; i < pb.n; ++i)
+    {
+        // bounds of t v_i
+        double lo = squared ? max(0.0, pb.lb[i]) * max(0.0, pb.lb[i]) : pb.lb[i];
+        double hi = squared ? pb.ub[i] * pb.ub[i] : pb.ub[i];
+        if (v[i] == 0)
+        {
+            if (lo > 0 || hi < 0)
+                return {};
+            continue;
+        }
+        double a = lo / v[i], b = hi / v[i];
+        tlo = max(tlo, min(a, b));
+        thi = min(thi, max(a, b));
+    }
+    vector<vector<double>> set;
+    if (!(tlo <= thi) || !isfinite(tlo) || !isfinite(thi))
+        return set;
+    int count = (tlo == thi) ? 0 : nb;
+    for (int k = 0; k <= count; ++k)
+    {
+        double t = (count == 0) ? tlo : tlo + (thi - tlo) * k / count;
+        vector<double> x(pb.n);
+        for (int i = 0; i < pb.n; ++i)
+        {
+            double z = t * v[i];
+            x[i] = min(pb.ub[i], max(pb.lb[i], squared ? sqrt(max(0.0, z)) : z));
+        }
+        set.push_back(x);
+    }
+    return set;
+}
+
+static vector<vector<double>> analytic_set(const Problem &pb)
+{
+    const int nb = 10000;
+    const string &name = pb.name;
+    if (name.compare(0, 3, "ZDT") == 0)
+    {
+        vector<double> v(pb.n, 0.0);
+        v[0] = 1;
+        return line_set(pb, v, false, nb);
+    }
+    // scalable variants (<base>-n<n>-s<seed>) are left to the sampling
+    bool squared = (name.compare(0, 3, "L3Z") == 0);
+    if (name == "DPAM1" || name == "L2ZDT6" || name == "L3ZDT6")
+        return line_set(pb, solve_e1<10>(rotation_A10()), squared, nb);
+    if (name == "L1ZDT4")
+        return line_set(pb, solve_e1<10>(rotation_D10()), false, nb);
+    if (name == "L2ZDT1")
+        return line_set(pb, solve_e1<30>(rotation_M30_L2ZDT1()), false, nb);
+    if (name == "L2ZDT2" || name == "L2ZDT3" || name == "L2ZDT4" || name == "L3ZDT1" || name == "L3ZDT2" ||
+        name == "L3ZDT3" || name == "L3ZDT4")
+        return line_set(pb, solve_e1<30>(rotation_M30()), squared, nb);
+    return {};
+}
+
+static vector<FrontPoint> build_front(const Problem &pb, int family, const Settings &s)
+{
+    int l = nb_constraints(family, pb.n);
+    uint32_t pair = stream_id(pb.name, family);
+
+    // 1. analytic Pareto set
+    vector<vector<double>> analytic = analytic_set(pb);
+    vector<FrontPoint> front;
+    {
+        vector<double> c(l);
+        for (vector<double> &x : analytic)
+            try_point(pb, family, x, c, front);
+        front = filter(move(front));
+    }
+
+    // 2. uniform sampling
+    vector<Violated> least(s.threads);
+    vector<FrontPoint> sampled = run_parallel(s.threads, [&](int t, vector<FrontPoint> &pts)
+                                              {
+        vector<double> x(pb.n), c(l);
+        size_t threshold = 65536;
+        for (uint64_t k = t; k < s.samples; k += s.threads)
+        {
+            RngStream rng = draw_stream(s, pair, 0, k);
+            for (int i = 0; i < pb.n; ++i)
+                x[i] = pb.lb[i] + rng.uniform() * (pb.ub[i] - pb.lb[i]);
+            double h = try_point(pb, family, x, c, pts);
+            if (h > 0)
+                keep_least_violated(least[t], h, x);
+            compact(pts, threshold);
+        } });
+    front.insert(front.end(), sampled.begin(), sampled.end());
+    front = filter(move(front));
+
+    // 3. violation search from the least violated samples and the analytic set
+    if (front.empty() && s.minimize_evals > 0)
+    {
+        Violated starts;
+        for (const Violated &b : least)
+        {
+            for (const auto &e : b)
+                keep_least_violated(starts, e.first, e.second);
+        }
+        for (size_t k = 0; k < analytic.size() && k < NB_STARTS; ++k)
+            starts.push_back({0, analytic[k * analytic.size() / min<size_t>(analytic.size(), NB_STARTS)]});
+        vector<double> c(l);
+        for (auto &start : starts)
+        {
+            if (minimize_violation(pb, family, start.second, s.minimize_evals / static_cast<int>(starts.size())) == 0)
+                try_point(pb, family, start.second, c, front);
+        }
+        front = filter(move(front));
+    }
+
+    // 4. local non-dominated refinement: chunks of s.perturbations draws, up
+    // to s.max_parents chunks per round, spread over the parents
+    double radius = 0.05;
+    for (int round = 0; round < s.rounds && !front.empty(); ++round, radius /= 2)
+    {
+        vector<const FrontPoint *> parents = spread(front, s.max_parents);
+        uint64_t chunks_per_parent = max<size_t>(1, s.max_parents / parents.size());
+        uint64_t chunks = chunks_per_parent * parents.size();
+        vector<FrontPoint> refined = run_parallel(s.threads, [&](int t, vector<FrontPoint> &pts)
+                                                  {
+            vector<double> x(pb.n), c(l);
+            size_t threshold = 65536;
+            for (uint64_t k = t; k < chunks; k += s.threads)
+            {
+                const FrontPoint *parent = parents[k / chunks_per_parent];
+                RngStream rng = draw_stream(s, pair, round + 1, k);
+                for (int trial = 0; trial < s.perturbations; ++trial)
+                {
+                    for (int i = 0; i < pb.n; ++i)
+                    {
+                        x[i] = parent->x[i] + radius * rng.uniform(-1.0, 1.0) * (pb.ub[i] - pb.lb[i]);
+                        x[i] = min(pb.ub[i], max(pb.lb[i], x[i]));
+                    }
+                    try_point(pb, family, x, c, pts);
+                }
+                compact(pts, threshold);
+            } });
+        front.insert(front.end(), refined.begin(), refined.end());
+        front = filter(move(front));
+    }
+
+    if (front.size() > s.max_points)
+    {
+        vector<FrontPoint> thinned;
+        for (const FrontPoint *p : spread(front, s.max_points))
+            thinned.push_back(*p);
+        front.swap(thinned);
+    }
+    return front;
+}
+
+static void usage()
+{
+    cerr << "Usage: reference_fronts [-p problem] [-f family] [-s samples] [-r rounds] "
+            "[-n max_points] [-t threads] [-d dir] [--seed seed] [--text]\n";
+    exit(EXIT_FAILURE);
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    Settings s;
+    string name;
+    int family = 0;
+    string dir = ".";
+    bool text = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc)
+            name = argv[++i];
+        else if (arg == "-f" && i + 1 < argc)
+            family = atoi(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc)
+            s.samples = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-r" && i + 1 < argc)
+            s.rounds = atoi(argv[++i]);
+        else if (arg == "-n" && i + 1 < argc)
+            s.max_points = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-t" && i + 1 < argc)
+            s.threads = max(1, atoi(argv[++i]));
+        else if (arg == "-d" && i + 1 < argc)
+            dir = argv[++i];
+        else if (arg == "--seed" && i + 1 < argc)
+            s.seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--text")
+            text = true;
+        else
+            usage();
+    }
+    // the phase and the high half of the draw index share the iteration field
+    // of the streams (draw_stream)
+    if (family < 0 || family > NB_FAMILIES || s.rounds < 0 || s.rounds >= (1 << 16) - 1 ||
+        s.samples >= (uint64_t(1) << 48))
+        usage();
+
+    try
+    {
+        // the problem of -p, any name known by find_problem (DTLZ, WFG and
+        // scalable variants too), or all the problems of the drivers
+        vector<const Problem *> problems;
+        if (name.empty())
+        {
+            for (const Problem &pb : all_problems())
+                problems.push_back(&pb);
+        }
+        else if (find_problem(name) != nullptr)
+            problems.push_back(find_problem(name));
+        else
+            throw runtime_error("unknown problem " + name);
+
+        for (const Problem *problem : problems)
+        {
+            const Problem &pb = *problem;
+            for (int fam = 1; fam <= NB_FAMILIES; ++fam)
+            {
+                if (family != 0 && fam != family)
+                    continue;
+
+                string path = front_path(dir, pb, fam);
+                vector<FrontPoint> front;
+                bool cached = load_front(path, pb, fam, s, front);
+                if (!cached)
+                {
+                    front = build_front(pb, fam, s);
+                    save_front(path, pb, fam, s, front);
+                }
+                cout << pb.name << "_" << fam << ": " << front.size() << " points"
+                     << (cached ? " (cached)" : "") << endl;
+
+                if (text)
+                {
+                    ofstream out(dir + "/" + pb.name + "_" + to_string(fam) + "_front.txt");
+                    out.precision(17);
+                    for (const FrontPoint &p : front)
+                    {
+                        for (int i = 0; i < pb.m; ++i)
+                            out << p.f[i] << (i + 1 < pb.m ? " " : "\n");
+                    }
+                }
+            }
+        }
+    }
+    catch (exception &e)
+    {
+        cerr << "\nreference_fronts has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*       Checks that the reference fronts do not depend on -t      */
+/*-----------------------------------------------------------------*/
+//
+// Runs reference_fronts with one thread and with N threads on the six
+// families of a few problems, each in its own directory, and compares the
+// binary caches (<problem>_<family>.front) and the objective vectors
+// (--text) byte for byte. The budget is small (-s 20000 -r 3) so that the
+// check runs in seconds; the caches of both runs must not be empty.
+//
+// Compile: g++ -O2 -std=c++17 -pthread reference_fronts_check.cpp -o reference_fronts_check
+//
+// Usage: reference_fronts_check reference_fronts_binary [-t threads]
+//   -t : threads of the second run (default: all the cores, at least 2)
+//   Prints one line per check and returns EXIT_FAILURE if one fails.
+
+const vector<string> PROBLEMS = {"CL1", "Kursawe", "L2ZDT4", "TKLY1", "ZDT1"};
+const int NB_FAMILIES = 6;
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "ok     " : "FAILED ") << what << endl;
+    if (!ok)
+        ++failures;
+}
+
+static string read_file(const string &filename, bool &found)
+{
+    ifstream in(filename, ios::binary);
+    found = static_cast<bool>(in);
+    ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+static bool run(const string &binary, const string &problem, int threads, const string &dir)
+{
+    string command = "'" + binary + "' -p " + problem + " -s 20000 -r 3 -t " + to_string(threads) + " -d " +
+                     dir + " --text > /dev/null";
+    int status = system(command.c_str());
+    return status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        cerr << "Usage: reference_fronts_check reference_fronts_binary [-t threads]" << endl;
+        return EXIT_FAILURE;
+    }
+    string binary = argv[1];
+    int threads = max(2, static_cast<int>(thread::hardware_concurrency()));
+    for (int i = 2; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc)
+            threads = max(2, atoi(argv[++i]));
+        else
+        {
+            cerr << "Usage: reference_fronts_check reference_fronts_binary [-t threads]" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    char tmpl[] = "/tmp/reference_fronts_check_XXXXXX";
+    if (mkdtemp(tmpl) == nullptr)
+    {
+        cerr << "\nreference_fronts_check has been interrupted (no temporary directory)\n\n";
+        return EXIT_FAILURE;
+    }
+    string dir = tmpl;
+    string dir1 = dir + "/t1", dirn = dir + "/t" + to_string(threads);
+    if (system(("mkdir -p " + dir1 + " " + dirn).c_str()) != 0)
+    {
+        cerr << "\nreference_fronts_check has been interrupted (cannot create " << dir << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    for (const string &problem : PROBLEMS)
+    {
+        if (!run(binary, problem, 1, dir1) || !run(binary, problem, threads, dirn))
+        {
+            check(false, problem + ": reference_fronts failed");
+            continue;
+        }
+        bool same = true, empty = true;
+        for (int family = 1; family <= NB_FAMILIES; ++family)
+        {
+            string pair = problem + "_" + to_string(family);
+            for (const string &file : {pair + ".front", pair + "_front.txt"})
+            {
+                bool found1, foundn;
+                string content1 = read_file(dir1 + "/" + file, found1);
+                string contentn = read_file(dirn + "/" + file, foundn);
+                same = same && found1 && foundn && content1 == contentn;
+                if (file == pair + "_front.txt")
+                    empty = empty && content1.empty();
+            }
+        }
+        check(same && !empty, problem + ": same fronts with 1 and " + to_string(threads) + " threads");
+    }
+
+    if (failures == 0)
+        system(("rm -rf " + dir).c_str());
+    else
+        cout << "        see " << dir << endl;
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+#ifndef RNG_STREAMS_HPP
+#define RNG_STREAMS_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+/*-----------------------------------------------------------------*/
+/*       Counter-based random streams (Philox4x32-10)              */
+/*-----------------------------------------------------------------*/
+//
+// Philox4x32 with 10 rounds (Salmon et al., "Parallel random numbers: as
+// easy as 1, 2, 3", SC 2011), the generator of Random123 and of curand. A
+// block of 4 random 32-bit words is a pure function of a 128-bit counter
+// and a 64-bit key, so a draw does not depend on the draws made before it
+// by other tasks.
+//
+// RngStream(seed, subproblem, iteration, candidate) is the stream of one
+// task: the key is the seed and the counter (candidate, iteration,
+// subproblem, block). Each task, whatever the thread that runs it and
+// whenever it runs, gets the same numbers, so a parallel run is identical
+// for any number of threads. A stream holds 2^32 blocks (2^34 words).
+//
+// uniform() is computed here from the bits, not by <random> distributions
+// whose algorithm differs between standard libraries.
+
+class Philox4x32
+{
+public:
+    typedef std::array<uint32_t, 4> Counter;
+    typedef std::array<uint32_t, 2> Key;
+
+    static Counter block(Counter ctr, Key key)
+    {
+        for (int round = 0; round < 10; ++round)
+        {
+            if (round > 0)
+            {
+                key[0] += 0x9E3779B9u; // golden ratio
+                key[1] += 0xBB67AE85u; // sqrt(3) - 1
+            }
+            uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * ctr[0];
+            uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * ctr[2];
+            uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+            uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+            ctr = Counter{hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        }
+        return ctr;
+    }
+};
+
+class RngStream
+{
+    Philox4x32::Key key;
+    Philox4x32::Counter ctr;
+    Philox4x32::Counter buf;
+    int used = 4; // words of buf already returned
+
+public:
+    typedef uint64_t result_type;
+
+    RngStream(uint64_t seed, uint32_t subproblem, uint32_t iteration = 0, uint32_t candidate = 0)
+        : key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          ctr{candidate, iteration, subproblem, 0}, buf{0, 0, 0, 0}
+    {
+    }
+
+    uint32_t next_u32()
+    {
+        if (used == 4)
+        {
+            buf = Philox4x32::block(ctr, key);
+            ++ctr[3];
+            used = 0;
+        }
+        return buf[used++];
+    }
+
+    // UniformRandomBitGenerator, e.g. for std::shuffle
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    result_type operator()()
+    {
+        uint64_t hi = next_u32();
+        return (hi << 32) | next_u32();
+    }
+
+    // in [0, 1), 53 random bits
+    double uniform()
+    {
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // in [lo, hi)
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * uniform();
+    }
+};
+
+// 32-bit identifier of a name, the same on every platform (FNV-1a), for the
+// subproblem field of a stream
+inline uint32_t stream_id(const std::string &name, uint32_t salt = 0)
+{
+    uint32_t h = 2166136261u ^ salt;
+    for (unsigned char ch : name)
+    {
+        h ^= ch;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "rng_streams.hpp"
+using namespace std;
+
+/*-----------------------------------------------------------------*/
+/*           Checks of the counter-based random streams            */
+/*-----------------------------------------------------------------*/
+//
+//  1. Philox4x32-10 against the known-answer vectors of Random123;
+//  2. draws of tasks spread over 1 to 64 threads, in interleaved or
+//     reversed order: every task must get exactly the same bits as when the
+//     tasks are run one after another;
+//  3. streams of different (seed, subproblem, iteration, candidate) differ
+//     and uniform() stays in [0, 1).
+//
+// Compile: g++ -O2 -std=c++17 -pthread rng_streams_check.cpp -o rng_streams_check
+//
+// Usage: rng_streams_check
+//   Prints one line per check and returns EXIT_FAILURE if one fails.
+
+const int NB_TASKS = 10000;
+const int DRAWS = 37; // not a multiple of 4: tasks end in the middle of a block
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "ok     " : "FAILED ") << what << endl;
+    if (!ok)
+        ++failures;
+}
+
+// draws of task k (subproblem 3, iteration 5, candidate k)
+static void run_task(uint64_t seed, int k, double *out)
+{
+    RngStream rng(seed, 3, 5, static_cast<uint32_t>(k));
+    for (int d = 0; d < DRAWS; ++d)
+        out[d] = rng.uniform();
+}
+
+static vector<double> run_tasks(uint64_t seed, int nthreads, bool reversed)
+{
+    vector<double> res(static_cast<size_t>(NB_TASKS) * DRAWS);
+    vector<thread> pool;
+    for (int t = 0; t < nthreads; ++t)
+    {
+        pool.emplace_back([&, t]()
+                          {
+            for (int j = t; j < NB_TASKS; j += nthreads)
+            {
+                int k = reversed ? NB_TASKS - 1 - j : j;
+                run_task(seed, k, &res[static_cast<size_t>(k) * DRAWS]);
+            } });
+    }
+    for (thread &th : pool)
+        th.join();
+    return res;
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main()
+{
+    // 1. known answers
+    {
+        Philox4x32::Counter a = Philox4x32::block({0, 0, 0, 0}, {0, 0});
+        check(a == Philox4x32::Counter{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}, "philox4x32-10 zero");
+        Philox4x32::Counter b = Philox4x32::block({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+                                                  {0xffffffffu, 0xffffffffu});
+        check(b == Philox4x32::Counter{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}, "philox4x32-10 ones");
+        Philox4x32::Counter c = Philox4x32::block({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+                                                  {0xa4093822u, 0x299f31d0u});
+        check(c == Philox4x32::Counter{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}, "philox4x32-10 pi");
+    }
+
+    // 2. same bits whatever the number of threads and the order of the tasks
+    {
+        uint64_t seed = 1234;
+        vector<double> reference = run_tasks(seed, 1, false);
+        for (int nthreads = 1; nthreads <= 64; nthreads *= 2)
+        {
+            for (bool reversed : {false, true})
+            {
+                vector<double> res = run_tasks(seed, nthreads, reversed);
+                bool same = memcmp(res.data(), reference.data(), res.size() * sizeof(double)) == 0;
+                check(same, to_string(nthreads) + " threads" + (reversed ? ", reversed order" : ""));
+            }
+        }
+    }
+
+    // 3. distinct streams, range of uniform()
+    {
+        vector<uint64_t> first;
+        for (uint32_t field = 0; field < 4; ++field)
+        {
+            for (uint32_t v = 0; v < 64; ++v)
+            {
+                uint32_t f[4] = {0, 0, 0, 0};
+                f[field] = v;
+                RngStream rng(1234 + f[0], f[1], f[2], f[3]);
+                first.push_back(rng());
+            }
+        }
+        sort(first.begin(), first.end());
+        size_t distinct = unique(first.begin(), first.end()) - first.begin();
+        check(distinct == 4 * 64 - 3, "streams of different keys differ"); // v = 0 is the same stream 4 times
+
+        RngStream rng(1, 2, 3, 4);
+        bool in_range = true;
+        double sum = 0;
+        const int nb = 1000000;
+        for (int k = 0; k < nb; ++k)
+        {
+            double u = rng.uniform();
+            in_range = in_range && u >= 0 && u < 1;
+            sum += u;
+        }
+        check(in_range, "uniform() in [0, 1)");
+        check(abs(sum / nb - 0.5) < 0.002, "mean of uniform() close to 1/2");
+
+        vector<int> p1(100), p2(100);
+        iota(p1.begin(), p1.end(), 0);
+        iota(p2.begin(), p2.end(), 0);
+        RngStream s1(7, 1), s2(7, 1);
+        shuffle(p1.begin(), p1.end(), s1);
+        shuffle(p2.begin(), p2.end(), s2);
+        check(p1 == p2, "std::shuffle with a stream");
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
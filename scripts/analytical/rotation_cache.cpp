@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../problems/cpp/rotation_cache.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*     Writes and checks the cache file of the rotation matrices   */
+/*-----------------------------------------------------------------*/
+//
+// -o writes A10, D10, M30 and M30_L2ZDT1 (the matrices of the problems),
+// and the generated matrices given by -g, to one file mapped by the C++
+// (RotationCache), Julia and MATLAB (load_rotation) readers. Format and
+// generators are described in problems/cpp/rotation_cache.hpp.
+//
+// --check maps a cache and, for each matrix, checks its hash and compares
+// it bit for bit with its generator; the matrices of the problems are also
+// compared with the literals of rotation_matrices.hpp.
+//
+// Compile: g++ -O3 -std=c++17 rotation_cache.cpp -o rotation_cache
+//
+// Usage: rotation_cache -o file [-g name]...
+//        rotation_cache --check file
+//   -g : givens-n<n>-s<seed> or uniform-n<n>-s<seed>, e.g. -g givens-n1000-s1
+//   --check prints one line per matrix and returns EXIT_FAILURE if one fails.
+
+static void usage()
+{
+    cerr << "Usage: rotation_cache -o file [-g name]...\n"
+            "       rotation_cache --check file\n";
+    exit(EXIT_FAILURE);
+}
+
+// the literal of rotation_matrices.hpp for the matrices of the problems
+static const double *literal(const string &name)
+{
+    if (name == "A10")
+        return &MATRIX_A10[0][0];
+    if (name == "D10")
+        return &MATRIX_D10[0][0];
+    if (name == "M30")
+        return &MATRIX_M30[0][0];
+    if (name == "M30_L2ZDT1")
+        return &MATRIX_M30_L2ZDT1[0][0];
+    return nullptr;
+}
+
+static int check_cache(const string &path)
+{
+    RotationCache cache(path);
+    int failures = 0;
+    for (const string &name : cache.names())
+    {
+        int rows = 0, cols = 0;
+        const double *values = cache.find(name, rows, cols);
+        RotationMatrix r = generate_rotation(name);
+        size_t nb = static_cast<size_t>(rows) * cols;
+        bool ok = cache.verify(name) && r.rows == rows && r.cols == cols &&
+                  memcmp(values, r.values.data(), nb * sizeof(double)) == 0;
+        const double *lit = literal(name);
+        if (lit != nullptr)
+            ok = ok && memcmp(values, lit, nb * sizeof(double)) == 0;
+        cout << (ok ? "ok     " : "FAILED ") << name << " (" << rows << " x " << cols << ")"
+             << (lit != nullptr ? ", same as rotation_matrices.hpp" : "") << endl;
+        failures += !ok;
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    string output, checked;
+    vector<string> names = {"A10", "D10", "M30", "M30_L2ZDT1"};
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if (arg == "-g" && i + 1 < argc)
+            names.push_back(argv[++i]);
+        else if (arg == "--check" && i + 1 < argc)
+            checked = argv[++i];
+        else
+            usage();
+    }
+    if (output.empty() == checked.empty())
+        usage();
+
+    try
+    {
+        if (!checked.empty())
+            return check_cache(checked);
+
+        vector<RotationMatrix> matrices;
+        for (const string &name : names)
+            matrices.push_back(generate_rotation(name));
+        RotationCache::write(output, matrices);
+    }
+    catch (exception &e)
+    {
+        cerr << "\nrotation_cache has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
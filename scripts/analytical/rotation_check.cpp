@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../problems/cpp/problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*   Structured rotations and scalable rotated ZDT problems        */
+/*-----------------------------------------------------------------*/
+//
+//  1. StructuredRotation is orthogonal (max |Q^T Q - I| <= 1e-13) and
+//     depends only on its seed, for sizes up to 1000;
+//  2. the scalable problems of problems.hpp match the same expressions
+//     with the dense matrix of their rotation (relative difference <= 1e-12)
+//     and find_problem builds them from their name;
+//  3. evaluations per second of L2ZDT1 and L3ZDT4 with the structured
+//     rotation against the dense product, for growing n.
+//
+// Compile: g++ -O3 -march=native -std=c++17 rotation_check.cpp -o rotation_check
+//
+// Usage: rotation_check [-s seed] [-e evaluations] [-n max_n]
+//   -s : seed of the rotations (default 1)
+//   -e : evaluations per timing (default 2000)
+//   -n : largest n of the timings (default 10000; the dense matrix is skipped
+//        beyond 2000)
+//   Prints one line per check and returns EXIT_FAILURE if one fails.
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "ok     " : "FAILED ") << what << endl;
+    if (!ok)
+        ++failures;
+}
+
+static string fmt(double v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3g", v);
+    return buf;
+}
+
+static void usage()
+{
+    cerr << "Usage: rotation_check [-s seed] [-e evaluations] [-n max_n]\n";
+    exit(EXIT_FAILURE);
+}
+
+static double orthogonality_error(const vector<double> &q, int n)
+{
+    double worst = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            double dot = 0;
+            for (int k = 0; k < n; ++k)
+                dot += q[static_cast<size_t>(k) * n + i] * q[static_cast<size_t>(k) * n + j];
+            worst = max(worst, fabs(dot - (i == j ? 1 : 0)));
+        }
+    }
+    return worst;
+}
+
+static void check_rotations(uint64_t seed)
+{
+    for (int n : {2, 3, 10, 30, 100, 257, 1000})
+    {
+        StructuredRotation rot(n, seed);
+        vector<double> q = rot.dense();
+        double err = orthogonality_error(q, n);
+        bool same = StructuredRotation(n, seed).dense() == q;
+        bool differs = (n < 2) || StructuredRotation(n, seed + 1).dense() != q;
+        check(err <= 1e-13 && same && differs, "rotation n = " + to_string(n) + ": max |Q^T Q - I| " + fmt(err) +
+                                                   (same ? "" : ", not reproducible") +
+                                                   (differs ? "" : ", same for another seed"));
+    }
+}
+
+/*----------------------------------------*/
+/*       objectives with dense matrix     */
+/*----------------------------------------*/
+
+// same expressions as scalable_problem, y = Q x with the dense Q
+static void dense_objectives(const string &base, const vector<double> &q, int n, const double *x, double *f)
+{
+    bool l1 = (base == "L1ZDT4");
+    int nr = l1 ? n - 1 : n;
+    int off = l1 ? 1 : 0;
+    vector<double> xs(nr), y(n);
+    for (int j = 0; j < nr; ++j)
+        xs[j] = (base[1] == '3') ? x[off + j] * x[off + j] : x[off + j];
+    y[0] = x[0];
+    for (int i = 0; i < nr; ++i)
+    {
+        double s = 0;
+        for (int j = 0; j < nr; ++j)
+            s += q[static_cast<size_t>(i) * nr + j] * xs[j];
+        y[off + i] = s;
+    }
+    f[0] = y[0] * y[0];
+    double g;
+    switch (base.back())
+    {
+    case '4':
+        g = lzdt4_g(y.data(), n);
+        f[1] = g * (1 - sqrt(f[0] / g));
+        break;
+    case '6':
+        g = lzdt6_g(y.data(), n);
+        f[1] = g * (1 - (f[0] / g) * (f[0] / g));
+        break;
+    case '1':
+        g = lzdt_g(y.data(), n);
+        f[1] = g * (1 - sqrt(f[0] / g));
+        break;
+    case '2':
+        g = lzdt_g(y.data(), n);
+        f[1] = g * (1 - (f[0] / g) * (f[0] / g));
+        break;
+    default:
+        g = lzdt_g(y.data(), n);
+        f[1] = g * (1 - sqrt(f[0] / g) - (f[0] / g) * sin(10 * PI * f[0]));
+    }
+}
+
+static vector<double> random_point(mt19937_64 &gen, const Problem &pb)
+{
+    vector<double> x(pb.n);
+    for (int i = 0; i < pb.n; ++i)
+        x[i] = uniform_real_distribution<double>(pb.lb[i], pb.ub[i])(gen);
+    return x;
+}
+
+static void check_problems(uint64_t seed)
+{
+    mt19937_64 gen(seed);
+    for (const string base : {"L1ZDT4", "L2ZDT1", "L2ZDT2", "L2ZDT3", "L2ZDT4", "L2ZDT6", "L3ZDT1", "L3ZDT2",
+                              "L3ZDT3", "L3ZDT4", "L3ZDT6"})
+    {
+        for (int n : {10, 30, 200})
+        {
+            const Problem *pb = find_problem(scalable_name(base, n, seed));
+            if (pb == nullptr || pb->n != n)
+            {
+                check(false, scalable_name(base, n, seed) + ": not found");
+                continue;
+            }
+            vector<double> q = StructuredRotation(base == "L1ZDT4" ? n - 1 : n, seed).dense();
+            double worst = 0;
+            for (int t = 0; t < 100; ++t)
+            {
+                vector<double> x = random_point(gen, *pb);
+                double f[2], fd[2];
+                pb->objectives(x.data(), f);
+                dense_objectives(base, q, n, x.data(), fd);
+                for (int j = 0; j < 2; ++j)
+                    worst = max(worst, fabs(f[j] - fd[j]) / max(1.0, fabs(fd[j])));
+            }
+            check(worst <= 1e-12, pb->name + ": max difference with the dense matrix " + fmt(worst));
+        }
+    }
+    check(find_problem("L2ZDT1-n30") == nullptr && find_problem("ZDT1-n30-s1") == nullptr &&
+              find_problem("L2ZDT1-n1-s1") == nullptr && find_problem("L2ZDT1-n030-s1") == nullptr &&
+              find_problem("L2ZDT1-n30-s1") == find_problem("L2ZDT1-n30-s1"),
+          "malformed names rejected, problems built once");
+}
+
+/*----------------------------------------*/
+/*                timings                 */
+/*----------------------------------------*/
+
+static void time_problems(uint64_t seed, int evals, int max_n)
+{
+    mt19937_64 gen(seed);
+    for (const string base : {"L2ZDT1", "L3ZDT4"})
+    {
+        for (int n = 30; n <= max_n; n = (n < 200) ? 200 : n * 5)
+        {
+            const Problem *pb = find_problem(scalable_name(base, n, seed));
+            vector<double> x = random_point(gen, *pb);
+            double f[2], sink = 0;
+            auto start = chrono::steady_clock::now();
+            for (int e = 0; e < evals; ++e)
+            {
+                x[e % n] = pb->lb[e % n] + (pb->ub[e % n] - pb->lb[e % n]) * ((e % 7) / 7.0);
+                pb->objectives(x.data(), f);
+                sink += f[1];
+            }
+            double structured = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            string line = pb->name + ": structured " + fmt(evals / structured) + " evals/s";
+            if (n <= 2000)
+            {
+                vector<double> q = StructuredRotation(n, seed).dense();
+                start = chrono::steady_clock::now();
+                for (int e = 0; e < evals; ++e)
+                {
+                    x[e % n] = pb->lb[e % n] + (pb->ub[e % n] - pb->lb[e % n]) * ((e % 7) / 7.0);
+                    dense_objectives(base, q, n, x.data(), f);
+                    sink += f[1];
+                }
+                double dense = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                line += ", dense " + fmt(evals / dense) + " evals/s, speedup " + fmt(dense / structured);
+            }
+            check(!isnan(sink), line);
+        }
+    }
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    uint64_t seed = 1;
+    int evals = 2000, max_n = 10000;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-s" && i + 1 < argc)
+            seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-e" && i + 1 < argc)
+            evals = max(1, atoi(argv[++i]));
+        else if (arg == "-n" && i + 1 < argc)
+            max_n = max(30, atoi(argv[++i]));
+        else
+            usage();
+    }
+
+    try
+    {
+        check_rotations(seed);
+        check_problems(seed);
+        time_problems(seed, evals, max_n);
+    }
+    catch (exception &e)
+    {
+        cerr << "\nrotation_check has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,33 @@
+# Solve one job of the analytical campaign; used by the campaign scheduler
+# (campaign.cpp) to run DMulti-MADS jobs as subprocesses:
+#
+#   julia run_analytical_job.jl <problem> <type of constraints> <variant> <seed> <cache file>
+#
+# e.g. julia run_analytical_job.jl L2ZDT1 1 PB 1234 L2ZDT1_1_dmultimadsPB_1234.txt
+#
+# With BBPROBLEMS_LIB=/path/to/libbbproblems.so in the environment, the
+# objectives come from the C++ problems when they have the problem (see
+# analytical_problems.jl).
+
+using Pkg
+Pkg.activate("../../../DMultiMadsPB")
+using MATLAB
+import DataStructures.SortedDict
+using DMultiMadsPB
+
+include("analytical_problems.jl")
+
+if length(ARGS) != 5
+    println("Usage: julia run_analytical_job.jl <problem> <type of constraints> <variant> <seed> <cache file>")
+    exit(1)
+end
+
+name_prob = ARGS[1]
+type_id = parse(Int, ARGS[2])
+variant = ARGS[3]
+seed = parse(Int, ARGS[4])
+
+# Load matlab problems
+MATLAB.mxcall(:addpath, 0, "../../problems/matlab")
+
+solve_analytical_job(name_prob, type_id, variant, seed, ARGS[5])
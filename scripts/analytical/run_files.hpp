@@ -0,0 +1,185 @@
+#ifndef RUN_FILES_HPP
+#define RUN_FILES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*-----------------------------------------------------------------*/
+/*  Readers for the per-seed output files of the analytical runs   */
+/*-----------------------------------------------------------------*/
+//
+// Two formats are produced by the campaign scripts:
+//  - caches (DMulti-MADS save_cache, NSGA-II write_cache): a header line
+//    with two integers, then one line "x_1 .. x_n f_1 .. f_m c_1 .. c_p"
+//    per evaluation;
+//  - NOMAD history files (BiMADS set_HISTORY_FILE): the same rows
+//    without header, so the number of inputs must be given.
+// Columns may be separated by spaces or tabs.
+
+// one evaluation of the blackbox
+struct RunEval
+{
+    std::vector<double> x; // inputs
+    std::vector<double> f; // objectives
+    std::vector<double> c; // constraints (feasible iff all <= 0)
+
+    bool is_feasible() const
+    {
+        for (double cj : c)
+        {
+            if (!(cj <= 0))
+                return false;
+        }
+        return true;
+    }
+};
+
+// all evaluations of one run (one seed)
+struct Run
+{
+    std::string filename;
+    int n = 0; // number of inputs
+    int m = 0; // number of objectives
+    std::vector<RunEval> evals;
+};
+
+inline std::vector<double> parse_row(const std::string &line)
+{
+    std::vector<double> row;
+    std::istringstream iss(line);
+    std::string tok;
+    while (iss >> tok)
+    {
+        row.push_back(std::stod(tok));
+    }
+    return row;
+}
+
+// read the content of a cache or history file; n <= 0 means that the number
+// of inputs is read from the header line of a cache
+inline Run read_run(std::istream &in, const std::string &filename, int m, int n = 0)
+{
+    Run run;
+    run.filename = filename;
+    run.m = m;
+    run.n = n;
+
+    std::string line;
+    bool first = true;
+    while (std::getline(in, line))
+    {
+        std::vector<double> row = parse_row(line);
+        if (row.empty())
+            continue;
+
+        // cache header: two integers, the first one being the dimension
+        if (first && row.size() == 2 && n <= 0)
+        {
+            run.n = static_cast<int>(row[0]);
+            first = false;
+            continue;
+        }
+        first = false;
+
+        if (run.n <= 0)
+            throw std::runtime_error(filename + ": unknown number of inputs");
+        if (static_cast<int>(row.size()) < run.n + m)
+            throw std::runtime_error(filename + ": truncated row");
+
+        RunEval e;
+        e.x.assign(row.begin(), row.begin() + run.n);
+        e.f.assign(row.begin() + run.n, row.begin() + run.n + m);
+        e.c.assign(row.begin() + run.n + m, row.end());
+        run.evals.push_back(std::move(e));
+    }
+    return run;
+}
+
+inline Run read_run_file(const std::string &filename, int m, int n = 0)
+{
+    std::ifstream in(filename);
+    if (!in)
+        throw std::runtime_error("cannot open " + filename);
+    return read_run(in, filename, m, n);
+}
+
+// true if a weakly dominates b and a != b
+inline bool dominates(const std::vector<double> &a, const std::vector<double> &b)
+{
+    bool strict = false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i] > b[i])
+            return false;
+        if (a[i] < b[i])
+            strict = true;
+    }
+    return strict;
+}
+
+// non-dominated elements of pts, obj(p) giving the objective vector of p;
+// elements with equal objective vectors are kept once
+template <class T, class Obj>
+std::vector<T> nondominated(std::vector<T> pts, Obj obj)
+{
+    // stable: of equal objective vectors, the first one is kept
+    std::stable_sort(pts.begin(), pts.end(), [&](const T &a, const T &b)
+                     { return obj(a) < obj(b); });
+    pts.erase(std::unique(pts.begin(), pts.end(), [&](const T &a, const T &b)
+                          { return obj(a) == obj(b); }),
+              pts.end());
+
+    std::vector<T> front;
+    if (!pts.empty() && obj(pts[0]).size() == 2)
+    {
+        // lexicographic order: a single sweep on the second objective
+        double best = INFINITY;
+        for (const T &p : pts)
+        {
+            if (obj(p)[1] < best)
+            {
+                front.push_back(p);
+                best = obj(p)[1];
+            }
+        }
+        return front;
+    }
+
+    // in lexicographic order, a point can only be dominated by a previous one
+    for (const T &p : pts)
+    {
+        bool dominated = false;
+        for (const T &q : front)
+        {
+            if (dominates(obj(q), obj(p)))
+            {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated)
+            front.push_back(p);
+    }
+    return front;
+}
+
+// non-dominated objective vectors of the feasible evaluations of a run
+inline std::vector<std::vector<double>> feasible_front(const Run &run)
+{
+    std::vector<std::vector<double>> pts;
+    for (const RunEval &e : run.evals)
+    {
+        if (e.is_feasible())
+            pts.push_back(e.f);
+    }
+    return nondominated(pts, [](const std::vector<double> &f) -> const std::vector<double> &
+                        { return f; });
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef SAMPLERS_HPP
+#define SAMPLERS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+/*-----------------------------------------------------------------*/
+/*     Space-filling samplers producing coordinate-major batches   */
+/*-----------------------------------------------------------------*/
+//
+// Both samplers fill x[i * ld + k] (coordinate i of point k) for a batch of
+// nb points in the box [lb, ub], the layout of PointBatch (x.resize(nb),
+// then next_batch(nb, lb, ub, x.data(), x.ld())).
+//  - LatinHypercube: each batch is a Latin hypercube of nb points (sliced
+//    design), so that memory does not grow with the total number of samples.
+//  - Sobol: Gray-code Sobol sequence on 32 bits, with primitive polynomials
+//    found by an order test and initial direction numbers m_i drawn from the
+//    seed, randomized by a digital shift.
+
+class LatinHypercube
+{
+    int n;
+    std::mt19937_64 rng;
+    std::vector<int> perm;
+
+public:
+    LatinHypercube(int dim, uint64_t seed) : n(dim), rng(seed) {}
+
+    void next_batch(int nb, const std::vector<double> &lb, const std::vector<double> &ub,
+                    double *x, size_t ld)
+    {
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        perm.resize(nb);
+        for (int i = 0; i < n; ++i)
+        {
+            std::iota(perm.begin(), perm.end(), 0);
+            std::shuffle(perm.begin(), perm.end(), rng);
+            for (int k = 0; k < nb; ++k)
+            {
+                x[i * ld + k] = lb[i] + (ub[i] - lb[i]) * (perm[k] + u(rng)) / nb;
+            }
+        }
+    }
+};
+
+class Sobol
+{
+    int n;
+    uint64_t index = 0;
+    std::vector<uint32_t> state;     // current point, one word per dimension
+    std::vector<uint32_t> shift;     // digital shift
+    std::vector<uint32_t> direction; // direction[i * 32 + b]
+
+    // multiplication modulo p over GF(2), polynomials stored as bit masks
+    static uint64_t mulmod(uint64_t a, uint64_t b, uint64_t p, int deg)
+    {
+        uint64_t r = 0;
+        while (b)
+        {
+            if (b & 1)
+                r ^= a;
+            b >>= 1;
+            a <<= 1;
+            if (a >> deg & 1)
+                a ^= p;
+        }
+        return r;
+    }
+
+    static uint64_t powmod(uint64_t e, uint64_t p, int deg)
+    {
+        uint64_t r = 1;
+        uint64_t a = (deg == 1) ? (2 ^ p) : 2; // the polynomial x modulo p
+        while (e)
+        {
+            if (e & 1)
+                r = mulmod(r, a, p, deg);
+            a = mulmod(a, a, p, deg);
+            e >>= 1;
+        }
+        return r;
+    }
+
+    // p of degree deg is primitive iff x has order 2^deg - 1 modulo p,
+    // i.e. x^(2^deg - 1) = 1 and x^((2^deg - 1) / q) != 1 for all prime q
+    static bool is_primitive(uint64_t p, int deg)
+    {
+        uint64_t order = (uint64_t(1) << deg) - 1;
+        if (powmod(order, p, deg) != 1)
+            return false;
+        uint64_t rest = order;
+        for (uint64_t q = 2; q * q <= rest; ++q)
+        {
+            if (rest % q != 0)
+                continue;
+            while (rest % q == 0)
+                rest /= q;
+            if (powmod(order / q, p, deg) == 1)
+                return false;
+        }
+        return rest == 1 || powmod(order / rest, p, deg) != 1;
+    }
+
+    // the first count primitive polynomials, by increasing degree
+    static std::vector<std::pair<uint64_t, int>> primitive_polynomials(int count)
+    {
+        std::vector<std::pair<uint64_t, int>> res;
+        for (int deg = 1; static_cast<int>(res.size()) < count; ++deg)
+        {
+            if (deg > 31)
+                throw std::runtime_error("Sobol: too many dimensions");
+            for (uint64_t low = 1; low < (uint64_t(1) << deg) && static_cast<int>(res.size()) < count; low += 2)
+            {
+                uint64_t p = (uint64_t(1) << deg) | low;
+                if (is_primitive(p, deg))
+                    res.push_back({p, deg});
+            }
+        }
+        return res;
+    }
+
+public:
+    Sobol(int dim, uint64_t seed) : n(dim), state(dim, 0), shift(dim), direction(dim * 32)
+    {
+        std::mt19937_64 rng(seed);
+        for (int i = 0; i < n; ++i)
+        {
+            shift[i] = static_cast<uint32_t>(rng());
+        }
+
+        // first dimension: van der Corput sequence
+        for (int b = 0; b < 32; ++b)
+        {
+            direction[b] = uint32_t(1) << (31 - b);
+        }
+
+        std::vector<std::pair<uint64_t, int>> polys = primitive_polynomials(n - 1);
+        for (int i = 1; i < n; ++i)
+        {
+            uint64_t p = polys[i - 1].first;
+            int s = polys[i - 1].second;
+            uint32_t *v = &direction[i * 32];
+            for (int b = 0; b < std::min(s, 32); ++b)
+            {
+                // odd m < 2^(b+1)
+                uint32_t m = static_cast<uint32_t>(rng() % (uint64_t(1) << b)) * 2 + 1;
+                v[b] = m << (31 - b);
+            }
+            for (int b = s; b < 32; ++b)
+            {
+                v[b] = v[b - s] ^ (v[b - s] >> s);
+                for (int k = 1; k < s; ++k)
+                {
+                    if (p >> (s - k) & 1)
+                        v[b] ^= v[b - k];
+                }
+            }
+        }
+    }
+
+    void next_batch(int nb, const std::vector<double> &lb, const std::vector<double> &ub,
+                    double *x, size_t ld)
+    {
+        for (int k = 0; k < nb; ++k)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                double u = ((state[i] ^ shift[i]) + 0.5) / 4294967296.0;
+                x[i * ld + k] = lb[i] + (ub[i] - lb[i]) * u;
+            }
+
+            // Gray code: flip the direction of the lowest zero bit of index
+            int c = 0;
+            while (index >> c & 1)
+                ++c;
+            if (c >= 32)
+                throw std::runtime_error("Sobol: sequence exhausted");
+            ++index;
+            for (int i = 0; i < n; ++i)
+            {
+                state[i] ^= direction[i * 32 + c];
+            }
+        }
+    }
+};
+
+#endif
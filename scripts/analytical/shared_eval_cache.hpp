@@ -0,0 +1,521 @@
+#ifndef SHARED_EVAL_CACHE_HPP
+#define SHARED_EVAL_CACHE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <pthread.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+/*-----------------------------------------------------------------*/
+/*   Evaluation cache shared by the threads and processes of a run */
+/*-----------------------------------------------------------------*/
+//
+// Fixed-capacity hash table in an anonymous shared mapping: created before
+// fork(), it is seen by all the children, and it can be used by any number
+// of threads. Keys are input vectors, values the outputs of the blackbox,
+// each with the tag given by its writer (e.g. the run that evaluated it). It
+// also holds the evaluation budget of the whole run: a point is evaluated
+// only if reserve_evaluation() succeeds, whatever thread or process asks.
+//
+// The table is split into shards (a power of 2, 64 by default), each with
+// its own slots (open addressing, linear probing) and its own robust
+// process-shared mutex, on its own cache line: threads only wait for each
+// other when they hit the same shard, and a child killed while holding a
+// lock does not block the others. The budget and the entry counter are
+// lock-free atomics.
+//
+// A point whose shard is full spills into an unhashed area with its own
+// mutex, scanned only once something has spilled there. The spill area has
+// one slot per evaluation of the budget, so no evaluated point is ever lost;
+// insert() throws if it is full all the same (capacity set below the budget).
+//
+// With tolerance = 0 (default, as NOMAD), keys are compared exactly. With
+// tolerance > 0, x is found if a key y has max_i |x_i - y_i| <= tolerance
+// (as isincache of src/cache.jl, with 1e-9), and a point that close to a key
+// is not inserted. Points are hashed by cells of 1024 tolerances; a point
+// closer than the tolerance to the border of its cell is also looked for in
+// the neighbouring cell, so a lookup probes one cell almost always (and at
+// most 2^12 cells).
+
+class SharedEvalCache
+{
+    struct Header
+    {
+        std::atomic<long> used;  // evaluations reserved
+        std::atomic<long> count; // entries
+        std::atomic<long> spilled; // entries of the spill area
+        long budget;
+        long spill_capacity;
+        long shard_capacity; // slots per shard, a power of 2
+        int nshards;
+        int n;
+        int nout;
+        double tolerance;
+        double cell;
+    };
+
+    struct alignas(64) Shard
+    {
+        pthread_mutex_t mutex;
+    };
+
+    Header *h = nullptr;
+    Shard *shards = nullptr; // nshards, then the mutex of the spill area
+    char *slots = nullptr;
+    char *spill = nullptr;
+    size_t slot_size = 0;
+    size_t mapped = 0;
+    pid_t owner;
+
+    static const size_t MAX_BORDERS = 12;
+
+    static_assert(std::atomic<long>::is_always_lock_free, "the counters must be lock-free to be shared");
+
+    // slot: sequence number (0: empty, k: k-th entry), tag, x, outputs
+    char *slot(int shard, long s) const
+    {
+        return slots + (static_cast<size_t>(shard) * h->shard_capacity + s) * slot_size;
+    }
+    char *spill_slot(long s) const
+    {
+        return spill + static_cast<size_t>(s) * slot_size;
+    }
+    static int64_t &seq(char *sl)
+    {
+        return *reinterpret_cast<int64_t *>(sl);
+    }
+    static int64_t &tag(char *sl)
+    {
+        return *reinterpret_cast<int64_t *>(sl + sizeof(int64_t));
+    }
+    static double *key(char *sl)
+    {
+        return reinterpret_cast<double *>(sl + 2 * sizeof(int64_t));
+    }
+    double *value(char *sl) const
+    {
+        return key(sl) + h->n;
+    }
+
+    static uint64_t mix(uint64_t hv, uint64_t v)
+    {
+        hv ^= v + 0x9e3779b97f4a7c15ULL + (hv << 6) + (hv >> 2);
+        return hv;
+    }
+
+    static uint64_t finish(uint64_t z) // splitmix64
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // hashes of the cells where x or a key close to x can be
+    void candidates(const double *x, std::vector<uint64_t> &hashes) const
+    {
+        hashes.clear();
+        if (h->tolerance <= 0)
+        {
+            uint64_t hv = 0;
+            for (int i = 0; i < h->n; ++i)
+            {
+                double v = (x[i] == 0) ? 0.0 : x[i]; // -0 == 0
+                uint64_t bits;
+                std::memcpy(&bits, &v, sizeof(bits));
+                hv = mix(hv, bits);
+            }
+            hashes.push_back(finish(hv));
+            return;
+        }
+
+        std::vector<int64_t> cell(h->n);
+        std::vector<int> border; // coordinates near a border: -1 or +1
+        std::vector<int> near;
+        for (int i = 0; i < h->n; ++i)
+        {
+            // borders shifted off the round values (bounds, 0)
+            double shifted = x[i] / h->cell + 0.3819660112501051;
+            double q = std::floor(shifted);
+            cell[i] = static_cast<int64_t>(q);
+            double offset = (shifted - q) * h->cell;
+            if (offset <= h->tolerance)
+            {
+                near.push_back(i);
+                border.push_back(-1);
+            }
+            else if (h->cell - offset <= h->tolerance)
+            {
+                near.push_back(i);
+                border.push_back(+1);
+            }
+        }
+        // every combination of shifts of the coordinates near a border (of
+        // the first MAX_BORDERS of them)
+        size_t combinations = size_t(1) << std::min(near.size(), MAX_BORDERS);
+        for (size_t mask = 0; mask < combinations; ++mask)
+        {
+            uint64_t hv = 0;
+            size_t k = 0;
+            for (int i = 0; i < h->n; ++i)
+            {
+                int64_t c = cell[i];
+                if (k < near.size() && near[k] == i)
+                {
+                    if (k < MAX_BORDERS && (mask >> k) & 1)
+                        c += border[k];
+                    ++k;
+                }
+                hv = mix(hv, static_cast<uint64_t>(c));
+            }
+            hashes.push_back(finish(hv));
+        }
+    }
+
+    int shard_of(uint64_t hv) const
+    {
+        return static_cast<int>((hv >> 32) & static_cast<uint64_t>(h->nshards - 1));
+    }
+
+    bool same(const double *x, const double *y) const
+    {
+        if (h->tolerance <= 0)
+            return std::equal(x, x + h->n, y);
+        for (int i = 0; i < h->n; ++i)
+        {
+            if (!(std::fabs(x[i] - y[i]) <= h->tolerance))
+                return false;
+        }
+        return true;
+    }
+
+    // slot of a key matching x in the cell of hash hv, or nullptr
+    char *lookup(uint64_t hv, const double *x) const
+    {
+        int sh = shard_of(hv);
+        long mask = h->shard_capacity - 1;
+        long s = static_cast<long>(hv & static_cast<uint64_t>(mask));
+        for (long k = 0; k < h->shard_capacity; ++k, s = (s + 1) & mask)
+        {
+            char *sl = slot(sh, s);
+            if (seq(sl) == 0)
+                return nullptr;
+            if (same(x, key(sl)))
+                return sl;
+        }
+        return nullptr;
+    }
+
+    // first empty slot of the cell of hash hv, or nullptr if its shard is full
+    char *free_slot(uint64_t hv) const
+    {
+        int sh = shard_of(hv);
+        long mask = h->shard_capacity - 1;
+        long s = static_cast<long>(hv & static_cast<uint64_t>(mask));
+        for (long k = 0; k < h->shard_capacity; ++k, s = (s + 1) & mask)
+        {
+            char *sl = slot(sh, s);
+            if (seq(sl) == 0)
+                return sl;
+        }
+        return nullptr;
+    }
+
+    // slot of a key matching x in the spill area, or nullptr; the spill
+    // area must be locked
+    char *lookup_spill(const double *x) const
+    {
+        long nb = h->spilled.load();
+        for (long s = 0; s < nb; ++s)
+        {
+            if (same(x, key(spill_slot(s))))
+                return spill_slot(s);
+        }
+        return nullptr;
+    }
+
+    // lookup_spill with the spill area locked here
+    char *find_spilled(const double *x) const
+    {
+        lock(h->nshards);
+        char *sl = lookup_spill(x);
+        unlock(h->nshards);
+        return sl;
+    }
+
+    void lock(int sh) const
+    {
+        int rc = pthread_mutex_lock(&shards[sh].mutex);
+        if (rc == EOWNERDEAD)
+            pthread_mutex_consistent(&shards[sh].mutex);
+        else if (rc != 0)
+            throw std::runtime_error("cannot lock the evaluation cache");
+    }
+
+    void unlock(int sh) const
+    {
+        pthread_mutex_unlock(&shards[sh].mutex);
+    }
+
+    // locks the shards of hashes in increasing order (no deadlock)
+    std::vector<int> lock_all(const std::vector<uint64_t> &hashes) const
+    {
+        std::vector<int> locked;
+        for (uint64_t hv : hashes)
+            locked.push_back(shard_of(hv));
+        std::sort(locked.begin(), locked.end());
+        locked.erase(std::unique(locked.begin(), locked.end()), locked.end());
+        for (int sh : locked)
+            lock(sh);
+        return locked;
+    }
+
+    void unlock_all(const std::vector<int> &locked) const
+    {
+        for (int sh : locked)
+            unlock(sh);
+    }
+
+public:
+    // nout outputs per point, at most budget evaluations; capacity (default:
+    // twice the budget) and nshards are rounded up to powers of 2
+    SharedEvalCache(int n, int nout, long budget, long capacity = 0, double tolerance = 0, int nshards = 64)
+        : owner(getpid())
+    {
+        if (capacity <= 0)
+            capacity = 2 * std::max(1L, budget);
+        int ns = 1;
+        while (ns < nshards)
+            ns *= 2;
+        // room for an uneven spread of the points over the shards
+        long per_shard = std::max(16L, 2 * ((capacity + ns - 1) / ns));
+        long cap = 1;
+        while (cap < per_shard)
+            cap *= 2;
+
+        long spill_capacity = std::max(16L, budget);
+
+        slot_size = 2 * sizeof(int64_t) + sizeof(double) * (n + nout);
+        size_t header_size = (sizeof(Header) + 63) / 64 * 64;
+        size_t shards_size = sizeof(Shard) * (ns + 1);
+        mapped = header_size + shards_size + slot_size * (cap * ns + spill_capacity);
+        void *mem = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED)
+            throw std::runtime_error("cannot map an evaluation cache of " + std::to_string(cap * ns) + " points");
+        h = new (mem) Header;
+        shards = reinterpret_cast<Shard *>(static_cast<char *>(mem) + header_size);
+        slots = static_cast<char *>(mem) + header_size + shards_size; // zero-filled: all slots empty
+        spill = slots + slot_size * cap * ns;
+
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        for (int sh = 0; sh <= ns; ++sh)
+            pthread_mutex_init(&shards[sh].mutex, &attr);
+        pthread_mutexattr_destroy(&attr);
+        h->used = 0;
+        h->count = 0;
+        h->spilled = 0;
+        h->budget = budget;
+        h->spill_capacity = spill_capacity;
+        h->shard_capacity = cap;
+        h->nshards = ns;
+        h->n = n;
+        h->nout = nout;
+        h->tolerance = std::max(0.0, tolerance);
+        h->cell = 1024 * h->tolerance;
+    }
+
+    ~SharedEvalCache()
+    {
+        if (h != nullptr && getpid() == owner)
+        {
+            for (int sh = 0; sh <= h->nshards; ++sh)
+                pthread_mutex_destroy(&shards[sh].mutex);
+        }
+        if (h != nullptr)
+            munmap(h, mapped);
+    }
+
+    SharedEvalCache(const SharedEvalCache &) = delete;
+    SharedEvalCache &operator=(const SharedEvalCache &) = delete;
+
+    int dimension() const
+    {
+        return h->n;
+    }
+    int nb_outputs() const
+    {
+        return h->nout;
+    }
+    long budget() const
+    {
+        return h->budget;
+    }
+    int nb_shards() const
+    {
+        return h->nshards;
+    }
+    double tolerance() const
+    {
+        return h->tolerance;
+    }
+    // entries stored in the spill area
+    long nb_spilled() const
+    {
+        return h->spilled.load();
+    }
+
+    // copies the outputs of x in out if x is in the cache
+    bool find(const double *x, double *out) const
+    {
+        std::vector<uint64_t> hashes;
+        candidates(x, hashes);
+        if (hashes.size() == 1)
+        {
+            int sh = shard_of(hashes[0]);
+            lock(sh);
+            char *sl = lookup(hashes[0], x);
+            if (sl == nullptr && h->spilled.load() > 0)
+                sl = find_spilled(x);
+            if (sl != nullptr)
+                std::copy(value(sl), value(sl) + h->nout, out);
+            unlock(sh);
+            return sl != nullptr;
+        }
+
+        std::vector<int> locked = lock_all(hashes);
+        char *sl = nullptr;
+        for (size_t k = 0; k < hashes.size() && sl == nullptr; ++k)
+            sl = lookup(hashes[k], x);
+        if (sl == nullptr && h->spilled.load() > 0)
+            sl = find_spilled(x);
+        if (sl != nullptr)
+            std::copy(value(sl), value(sl) + h->nout, out);
+        unlock_all(locked);
+        return sl != nullptr;
+    }
+
+    // false if x (or a key within the tolerance) was already there, which
+    // keeps its tag; a point whose shard is full goes to the spill area, and
+    // if that is full too, throws
+    bool insert(const double *x, const double *out, long writer = 0)
+    {
+        std::vector<uint64_t> hashes;
+        candidates(x, hashes);
+        std::vector<int> locked = lock_all(hashes);
+        bool known = false;
+        for (size_t k = 0; k < hashes.size() && !known; ++k)
+            known = (lookup(hashes[k], x) != nullptr);
+        if (!known && h->spilled.load() > 0)
+            known = (find_spilled(x) != nullptr);
+        char *sl = known ? nullptr : free_slot(hashes[0]);
+        bool full = false;
+        if (!known && sl == nullptr)
+        {
+            // the last mutex: locked after the shards, as by find
+            lock(h->nshards);
+            if (lookup_spill(x) != nullptr)
+                known = true;
+            else if (h->spilled.load() < h->spill_capacity)
+                sl = spill_slot(h->spilled.load());
+            else
+                full = true;
+            if (sl != nullptr)
+            {
+                std::copy(x, x + h->n, key(sl));
+                std::copy(out, out + h->nout, value(sl));
+                tag(sl) = writer;
+                seq(sl) = ++h->count;
+                ++h->spilled; // published once the slot is written
+            }
+            unlock(h->nshards);
+        }
+        else if (sl != nullptr)
+        {
+            std::copy(x, x + h->n, key(sl));
+            std::copy(out, out + h->nout, value(sl));
+            tag(sl) = writer;
+            seq(sl) = ++h->count;
+        }
+        unlock_all(locked);
+        if (full)
+            throw std::runtime_error("evaluation cache full (" + std::to_string(h->spill_capacity) +
+                                     " points spilled)");
+        return sl != nullptr;
+    }
+
+    // takes one evaluation from the budget; false once it is exhausted
+    bool reserve_evaluation()
+    {
+        long used = h->used.load();
+        while (used < h->budget)
+        {
+            if (h->used.compare_exchange_weak(used, used + 1))
+                return true;
+        }
+        return false;
+    }
+
+    long evaluations() const
+    {
+        return h->used.load();
+    }
+
+    long size() const
+    {
+        return h->count.load();
+    }
+
+    // f(x, outputs) on every entry, in insertion order
+    template <class F>
+    void for_each(F f) const
+    {
+        for_each_tagged([&](const double *x, const double *out, long) { f(x, out); });
+    }
+
+    // f(x, outputs, tag) on every entry, in insertion order
+    template <class F>
+    void for_each_tagged(F f) const
+    {
+        struct Entry
+        {
+            int64_t seq;
+            long tag;
+            std::vector<double> values; // x, outputs
+        };
+        std::vector<Entry> entries;
+        auto keep = [&](char *sl)
+        { entries.push_back(Entry{seq(sl), static_cast<long>(tag(sl)), std::vector<double>(key(sl), key(sl) + h->n + h->nout)}); };
+        for (int sh = 0; sh < h->nshards; ++sh)
+        {
+            lock(sh);
+            for (long s = 0; s < h->shard_capacity; ++s)
+            {
+                char *sl = slot(sh, s);
+                if (seq(sl) != 0)
+                    keep(sl);
+            }
+            unlock(sh);
+        }
+        lock(h->nshards);
+        for (long s = 0; s < h->spilled.load(); ++s)
+            keep(spill_slot(s));
+        unlock(h->nshards);
+        std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.seq < b.seq; });
+
+        for (const Entry &e : entries)
+            f(e.values.data(), e.values.data() + h->n, e.tag);
+    }
+};
+
+#endif
@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "samplers.hpp"
+#include "../../problems/cpp/batch_constraints.hpp"
+#include "../../problems/cpp/batch_problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*       Accuracy and speed of the vectorized math functions       */
+/*-----------------------------------------------------------------*/
+//
+// For each instruction set of the CPU (or the one given by --isa):
+//  1. sin, cos, exp, log and pow of simd_math.hpp against long double libm,
+//     in ulp, on the domains of the problems and on wide domains: the maxima
+//     must stay within the bounds documented in simd_math.hpp;
+//  2. objectives of the batched kernels of batch_problems.hpp against the
+//     scalar functions of problems.hpp on points sampled in the bounds (the
+//     problems of all_problems, DTLZ1-6 for 2, 3, 5 and 10 objectives and
+//     WFG1-9): the differences relative to max(1, |f|) must stay below
+//     1e-13. For WFG9, they are relative to 1000 max(1, |f|): its s_decept
+//     multiplies the errors of pow on the values of b_param by 1 / B =
+//     1000 within B of A. For L2ZDT3 and L3ZDT3, f2 is compared relative to
+//     max(1, |f2|, 10 pi f1^2): f1 sin(10 pi f1) amplifies the differences
+//     of f1 = y1^2 by 10 pi f1, and the FMAs of the rotation y = M x (avx2,
+//     avx512) round y1 differently. For MOP4, f2 is compared relative to
+//     max(1, |f2|, sum_i |x_i|^3): sin(x_i^3) carries the errors of pow on
+//     x_i^3 (2 ulp with the vector packs). The evaluations per second of both
+//     are printed;
+//  3. constraints of the stencil kernels of batch_constraints.hpp (one
+//     point, batches, violations) against eval_constraints and
+//     eval_violation on the same points of every problem: differences
+//     relative to max(1, sum_j |c_j| of family 5) below 1e-13, same numbers
+//     of violated constraints. The points per second of eval_violation and
+//     of the batched violations are printed;
+//  4. PointBatch (point_batch.hpp) with the active instruction set: gather
+//     and scatter of point-major arrays and of lists of points give back
+//     the same values, and eval_objectives_batch, eval_constraints_batch and
+//     eval_violations_batch on a batch, or on a view of the same points,
+//     match the scalar functions within the tolerances and scales above.
+//
+// Compile: g++ -O3 -std=c++17 simd_math_check.cpp -o simd_math_check
+//   (no -march: every instruction set is compiled in and chosen at run time)
+//
+// Usage: simd_math_check [-p points] [-r repeats] [--isa name]
+//   -p    : points per function and per problem (default 100000)
+//   -r    : repetitions of the timed evaluations (default 20)
+//   --isa : scalar, sse42, avx2 or avx512 (default: each one of the CPU)
+//   Prints one line per check and returns EXIT_FAILURE if one fails.
+
+const int BATCH = 4096;
+const double OBJECTIVE_TOLERANCE = 1e-13;
+
+static int failures = 0;
+
+static void check(bool ok, const string &what)
+{
+    cout << (ok ? "ok     " : "FAILED ") << what << endl;
+    if (!ok)
+        ++failures;
+}
+
+static string fmt(double v)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3g", v);
+    return buf;
+}
+
+static void usage()
+{
+    cerr << "Usage: simd_math_check [-p points] [-r repeats] [--isa name]\n";
+    exit(EXIT_FAILURE);
+}
+
+// error of v in ulp of the exact value ref
+static double ulp_error(double v, long double ref)
+{
+    if (isnan(v) || isnan(static_cast<double>(ref)))
+        return (isnan(v) && isnan(static_cast<double>(ref))) ? 0 : INFINITY;
+    if (isinf(static_cast<double>(ref)) || v == ref)
+        return (v == static_cast<double>(ref)) ? 0 : INFINITY;
+    int e = max(ilogb(static_cast<double>(ref)), -1022);
+    return static_cast<double>(fabsl(v - ref) / ldexpl(1.0L, e - 52));
+}
+
+// maximum error of fn (pow with exponent p) over xs against ref, at most bound ulp
+template <class Ref>
+static void check_function(simd::Isa isa, const string &name, simd::MathFunction fn, double p,
+                           const vector<double> &xs, Ref ref, double bound)
+{
+    vector<double> ys(xs.size());
+    simd::apply(fn, static_cast<int>(xs.size()), xs.data(), ys.data(), p, isa);
+    double worst = 0, worst_x = 0;
+    bool within = true;
+    for (size_t k = 0; k < xs.size(); ++k)
+    {
+        double err = ulp_error(ys[k], ref(xs[k]));
+        within = within && err <= bound;
+        if (err > worst)
+        {
+            worst = err;
+            worst_x = xs[k];
+        }
+    }
+    check(within, string(simd::isa_name(isa)) + " " + name + ": max " + fmt(worst) + " ulp (x = " + fmt(worst_x) +
+                      ")");
+}
+
+static vector<double> uniform_points(mt19937_64 &gen, size_t nb, double lo, double hi)
+{
+    uniform_real_distribution<double> u(lo, hi);
+    vector<double> xs(nb);
+    for (double &x : xs)
+        x = u(gen);
+    return xs;
+}
+
+// 2^u, u uniform in [lo, hi]
+static vector<double> log_uniform_points(mt19937_64 &gen, size_t nb, double lo, double hi)
+{
+    vector<double> xs = uniform_points(gen, nb, lo, hi);
+    for (double &x : xs)
+        x = exp2(x);
+    return xs;
+}
+
+static void check_functions(simd::Isa isa, size_t nb)
+{
+    mt19937_64 gen(1234);
+    auto sin_ref = [](long double x)
+    { return sinl(x); };
+    auto cos_ref = [](long double x)
+    { return cosl(x); };
+    auto exp_ref = [](long double x)
+    { return expl(x); };
+
+    vector<double> trig = uniform_points(gen, nb, -100, 100);
+    check_function(isa, "sin |x| <= 100", simd::SIN, 0, trig, sin_ref, 1.5);
+    check_function(isa, "cos |x| <= 100", simd::COS, 0, trig, cos_ref, 1.5);
+    vector<double> wide = uniform_points(gen, nb, -1e6, 1e6);
+    check_function(isa, "sin |x| <= 1e6", simd::SIN, 0, wide, sin_ref, 2.5);
+    check_function(isa, "cos |x| <= 1e6", simd::COS, 0, wide, cos_ref, 2.5);
+
+    check_function(isa, "exp |x| <= 50", simd::EXP, 0, uniform_points(gen, nb, -50, 50), exp_ref, 1.0);
+    check_function(isa, "exp all x", simd::EXP, 0, uniform_points(gen, nb, -746, 710), exp_ref, 1.0);
+
+    check_function(isa, "log x > 0", simd::LOG, 0, log_uniform_points(gen, nb, -1074, 1024), [](long double x)
+                   { return logl(x); }, 1.0);
+
+    for (double p : {0.8, 1.0 / 3, 0.25})
+    {
+        check_function(isa, "pow(x, " + to_string(p) + ")", simd::POW, p, log_uniform_points(gen, nb, -80, 80),
+                       [p](long double x)
+                       { return powl(x, static_cast<long double>(p)); }, 2.0);
+    }
+}
+
+/*----------------------------------------*/
+/*          batched objectives            */
+/*----------------------------------------*/
+
+// scale of the differences on objective j of pb, f its values at x
+static double objective_scale(const Problem &pb, int j, const vector<double> &x, const vector<double> &f)
+{
+    double scale = max(1.0, fabs(f[j]));
+    if (j == 1 && (pb.name == "L2ZDT3" || pb.name == "L3ZDT3"))
+        scale = max(scale, 10 * PI * f[0] * f[0]);
+    if (j == 1 && pb.name == "MOP4")
+    {
+        double cubes = 0;
+        for (double v : x)
+            cubes += fabs(v * v * v);
+        scale = max(scale, cubes);
+    }
+    return pb.name == "WFG9" ? 1000 * scale : scale;
+}
+
+static void check_problem(simd::Isa isa, const Problem &pb, int nb, int repeats)
+{
+    function<void(int, const double *, size_t, double *)> kernel = batch_objectives(pb.name, isa);
+    int variant, m, n;
+    if (!kernel && parse_dtlz_name(pb.name, variant, m, n))
+    {
+        ScalableBatchObjectiveFunction dtlz = dtlz_batch_objectives(variant, m, isa);
+        kernel = [dtlz, n](int nb, const double *x, size_t ld, double *f) { dtlz(n, nb, x, ld, f); };
+    }
+    if (!kernel)
+        return;
+
+    nb = max(BATCH, nb / BATCH * BATCH);
+    vector<double> x(static_cast<size_t>(pb.n) * nb), f(static_cast<size_t>(pb.m) * nb);
+    LatinHypercube sampler(pb.n, 1234);
+    for (int b = 0; b < nb; b += BATCH)
+    {
+        vector<double> xb(static_cast<size_t>(pb.n) * BATCH);
+        sampler.next_batch(BATCH, pb.lb, pb.ub, xb.data(), BATCH);
+        for (int i = 0; i < pb.n; ++i)
+            copy(xb.begin() + i * BATCH, xb.begin() + (i + 1) * BATCH, x.begin() + static_cast<size_t>(i) * nb + b);
+    }
+
+    // differences, on a batch size that is not a multiple of the width
+    int nb_check = nb - 1;
+    kernel(nb_check, x.data(), nb, f.data());
+    double worst = 0;
+    vector<double> xk(pb.n), fk(pb.m);
+    for (int k = 0; k < nb_check; ++k)
+    {
+        for (int i = 0; i < pb.n; ++i)
+            xk[i] = x[static_cast<size_t>(i) * nb + k];
+        pb.objectives(xk.data(), fk.data());
+        for (int j = 0; j < pb.m; ++j)
+            worst = max(worst, fabs(f[static_cast<size_t>(j) * nb + k] - fk[j]) / objective_scale(pb, j, xk, fk));
+    }
+
+    // evaluations per second, scalar then batched
+    auto start = chrono::steady_clock::now();
+    double sink = 0;
+    for (int r = 0; r < repeats; ++r)
+    {
+        for (int k = 0; k < nb; ++k)
+        {
+            for (int i = 0; i < pb.n; ++i)
+                xk[i] = x[static_cast<size_t>(i) * nb + k];
+            pb.objectives(xk.data(), fk.data());
+            sink += fk[1];
+        }
+    }
+    double scalar = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        kernel(nb, x.data(), nb, f.data());
+        sink += f[nb];
+    }
+    double batched = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double evals = static_cast<double>(nb) * repeats;
+
+    check(worst <= OBJECTIVE_TOLERANCE && !isnan(sink),
+          string(simd::isa_name(isa)) + " " + pb.name + ": max difference " + fmt(worst) + ", scalar " +
+              fmt(evals / scalar) + " evals/s, batched " + fmt(evals / batched) + " evals/s, speedup " +
+              fmt(scalar / batched));
+}
+
+// DTLZ1-6 for 2, 3, 5 and 10 objectives, and WFG1-9
+static vector<const Problem *> many_objective_problems()
+{
+    vector<const Problem *> problems;
+    for (int variant = 1; variant <= 6; ++variant)
+    {
+        for (int m : {2, 3, 5, 10})
+            problems.push_back(find_problem(dtlz_name(variant, m, m + dtlz_default_k(variant) - 1)));
+    }
+    for (int variant = 1; variant <= 9; ++variant)
+        problems.push_back(find_problem("WFG" + to_string(variant)));
+    return problems;
+}
+
+/*----------------------------------------*/
+/*          stencil constraints           */
+/*----------------------------------------*/
+
+static void check_family(simd::Isa isa, int family, int nb, int repeats)
+{
+    ConstraintKernels kernels = constraint_kernels(family, isa);
+    nb = max(BATCH, nb / BATCH * BATCH);
+    double worst = 0, scalar = 0, batched = 0, evals = 0, sink = 0;
+    bool same_nviol = true;
+    for (const Problem &pb : all_problems())
+    {
+        int nc = nb_constraints(family, pb.n);
+        vector<double> x(static_cast<size_t>(pb.n) * nb), c(static_cast<size_t>(nc) * nb), h(nb);
+        vector<int> nviol(nb);
+        LatinHypercube sampler(pb.n, 1234);
+        sampler.next_batch(nb, pb.lb, pb.ub, x.data(), nb);
+
+        // differences, on a batch size that is not a multiple of the width
+        int nb_check = nb - 1;
+        kernels.batch(pb.n, nb_check, x.data(), nb, c.data(), nb);
+        kernels.violations(pb.n, nb_check, x.data(), nb, h.data(), nviol.data());
+        vector<double> xk(pb.n), ck(nc), cp(nc), c5(nb_constraints(5, pb.n));
+        for (int k = 0; k < nb_check; ++k)
+        {
+            for (int i = 0; i < pb.n; ++i)
+                xk[i] = x[static_cast<size_t>(i) * nb + k];
+            eval_constraints(family, pb.n, xk.data(), ck.data());
+            kernels.point(pb.n, xk.data(), cp.data());
+            eval_constraints(5, pb.n, xk.data(), c5.data());
+            double scale = 1;
+            for (double v : c5)
+                scale += fabs(v);
+            double hk;
+            int nviolk;
+            eval_violation(family, pb.n, xk.data(), hk, nviolk);
+            for (int j = 0; j < nc; ++j)
+            {
+                worst = max(worst, fabs(c[static_cast<size_t>(j) * nb + k] - ck[j]) / scale);
+                worst = max(worst, fabs(cp[j] - ck[j]) / scale);
+            }
+            worst = max(worst, fabs(h[k] - hk) / max(1.0, hk) / scale);
+            same_nviol = same_nviol && nviol[k] == nviolk;
+        }
+
+        // points per second, eval_violation then batched
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (int k = 0; k < nb; ++k)
+            {
+                for (int i = 0; i < pb.n; ++i)
+                    xk[i] = x[static_cast<size_t>(i) * nb + k];
+                double hk;
+                int nviolk;
+                eval_violation(family, pb.n, xk.data(), hk, nviolk);
+                sink += hk;
+            }
+        }
+        scalar += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            kernels.violations(pb.n, nb, x.data(), nb, h.data(), nviol.data());
+            sink += h[0];
+        }
+        batched += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        evals += static_cast<double>(nb) * repeats;
+    }
+
+    check(worst <= OBJECTIVE_TOLERANCE && same_nviol && !isnan(sink),
+          string(simd::isa_name(isa)) + " family " + to_string(family) + ": max difference " + fmt(worst) +
+              (same_nviol ? "" : ", numbers of violated constraints differ") + ", scalar " + fmt(evals / scalar) +
+              " points/s, batched " + fmt(evals / batched) + " points/s, speedup " + fmt(scalar / batched));
+}
+
+/*----------------------------------------*/
+/*              PointBatch                */
+/*----------------------------------------*/
+
+static void check_point_batch(const Problem &pb, int nb)
+{
+    // point-major points, like the n x nb matrices of Julia
+    mt19937_64 gen(1234);
+    vector<double> points(static_cast<size_t>(pb.n) * nb);
+    for (int k = 0; k < nb; ++k)
+        for (int i = 0; i < pb.n; ++i)
+            points[static_cast<size_t>(k) * pb.n + i] = uniform_real_distribution<double>(pb.lb[i], pb.ub[i])(gen);
+
+    PointBatch x(pb.n, 0), f, c, fv;
+    x.gather(nb, points.data(), pb.n);
+    vector<double> back(points.size());
+    x.scatter(back.data(), pb.n);
+    vector<const double *> list;
+    for (int k = 0; k < nb; ++k)
+        list.push_back(&points[static_cast<size_t>(k) * pb.n]);
+    PointBatch xl(pb.n, 0);
+    xl.gather(list.begin(), list.end(), [](const double *p, int i) { return p[i]; });
+    bool same = back == points && xl.size() == nb && x.ld() % PointBatch::PAD == 0 &&
+                reinterpret_cast<uintptr_t>(x.data()) % PointBatch::ALIGNMENT == 0;
+    for (int k = 0; k < nb; ++k)
+        for (int i = 0; i < pb.n; ++i)
+            same = same && xl(i, k) == x(i, k);
+
+    // coordinate-major copy of the points, read through a view
+    vector<double> cm(static_cast<size_t>(pb.n) * nb);
+    for (int i = 0; i < pb.n; ++i)
+        copy(x.coordinate(i), x.coordinate(i) + nb, cm.begin() + static_cast<size_t>(i) * nb);
+    PointBatch view = PointBatch::view(pb.n, nb, cm.data(), nb);
+
+    double worst = 0;
+    eval_objectives_batch(pb, x, f);
+    eval_objectives_batch(pb, view, fv);
+    vector<double> fk(pb.m);
+    for (int k = 0; k < nb; ++k)
+    {
+        vector<double> xk(&points[static_cast<size_t>(k) * pb.n], &points[static_cast<size_t>(k + 1) * pb.n]);
+        pb.objectives(xk.data(), fk.data());
+        for (int j = 0; j < pb.m; ++j)
+        {
+            worst = max(worst, fabs(f(j, k) - fk[j]) / objective_scale(pb, j, xk, fk));
+            same = same && f(j, k) == fv(j, k);
+        }
+    }
+
+    vector<double> h;
+    vector<int> nviol;
+    for (int family = 1; family <= NB_FAMILIES; ++family)
+    {
+        int nc = nb_constraints(family, pb.n);
+        eval_constraints_batch(family, x, c);
+        eval_violations_batch(family, view, h, nviol);
+        same = same && c.n() == nc && c.size() == nb && static_cast<int>(h.size()) == nb;
+        vector<double> ck(nc);
+        for (int k = 0; k < nb; ++k)
+        {
+            const double *xk = &points[static_cast<size_t>(k) * pb.n];
+            eval_constraints(family, pb.n, xk, ck.data());
+            double scale = 1;
+            for (int j = 0; j < nc; ++j)
+                scale += fabs(ck[j]);
+            for (int j = 0; j < nc; ++j)
+                worst = max(worst, fabs(c(j, k) - ck[j]) / scale);
+            int nv = 0;
+            double hk = 0;
+            eval_violation(family, pb.n, xk, hk, nv);
+            worst = max(worst, fabs(h[k] - hk) / max(1.0, hk));
+            same = same && nviol[k] == nv;
+        }
+    }
+    check(same && worst <= OBJECTIVE_TOLERANCE,
+          "PointBatch " + pb.name + ": " + to_string(nb) + " points, gather/scatter and views " +
+              (same ? "same" : "differ") + ", max difference " + fmt(worst));
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    int points = 100000, repeats = 20;
+    string isa_name;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc)
+            points = max(8, atoi(argv[++i]));
+        else if (arg == "-r" && i + 1 < argc)
+            repeats = max(1, atoi(argv[++i]));
+        else if (arg == "--isa" && i + 1 < argc)
+            isa_name = argv[++i];
+        else
+            usage();
+    }
+
+    try
+    {
+        vector<simd::Isa> isas;
+        if (!isa_name.empty())
+        {
+            simd::force_isa(simd::parse_isa(isa_name));
+            isas.push_back(simd::active_isa());
+        }
+        else
+        {
+            for (int i = 0; i < simd::NB_ISAS; ++i)
+            {
+                if (simd::cpu_supports(static_cast<simd::Isa>(i)))
+                    isas.push_back(static_cast<simd::Isa>(i));
+            }
+        }
+        cout << "isa: " << simd::isa_report() << "\n";
+        for (simd::Isa isa : isas)
+        {
+            check_functions(isa, static_cast<size_t>(points));
+            for (const Problem &pb : all_problems())
+                check_problem(isa, pb, points, repeats);
+            for (const Problem *pb : many_objective_problems())
+                check_problem(isa, *pb, points, repeats);
+            for (int family = 1; family <= NB_FAMILIES; ++family)
+                check_family(isa, family, points, repeats);
+        }
+        for (const Problem &pb : all_problems())
+            check_point_batch(pb, 1001);
+    }
+    catch (exception &e)
+    {
+        cerr << "\nsimd_math_check has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
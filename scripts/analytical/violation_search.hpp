@@ -0,0 +1,55 @@
+#ifndef VIOLATION_SEARCH_HPP
+#define VIOLATION_SEARCH_HPP
+
+#include <algorithm>
+#include <vector>
+#include "../../problems/cpp/problems.hpp"
+
+/*-----------------------------------------------------------------*/
+/*        Compass search on the violation of the constraints       */
+/*-----------------------------------------------------------------*/
+//
+// Minimizes h = sum_j max(0, c_j)^2 over the bounds of a problem from x,
+// until a feasible point is found or budget evaluations are used. Used by
+// feasibility_probe (is the pair feasible?) and reference_fronts (where to
+// start the refinement when no sample is feasible). Deterministic: the
+// coordinates and signs are polled in order.
+
+// h at the end (0 if feasible); x is moved to the best point found
+inline double minimize_violation(const bbproblems::Problem &pb, int family, std::vector<double> &x, int budget)
+{
+    double h;
+    int nviol;
+    bbproblems::eval_violation(family, pb.n, x.data(), h, nviol);
+
+    double step = 0.1;
+    int used = 1;
+    std::vector<double> y(pb.n);
+    while (used < budget && nviol > 0 && step > 1e-12)
+    {
+        bool improved = false;
+        for (int i = 0; i < pb.n && !improved && used < budget; ++i)
+        {
+            for (int sign = -1; sign <= 1 && !improved && used < budget; sign += 2)
+            {
+                y = x;
+                y[i] = std::min(pb.ub[i], std::max(pb.lb[i], x[i] + sign * step * (pb.ub[i] - pb.lb[i])));
+                double hy;
+                int nviol_y;
+                bbproblems::eval_violation(family, pb.n, y.data(), hy, nviol_y);
+                ++used;
+                if (nviol_y == 0 || hy < h)
+                {
+                    x.swap(y);
+                    h = hy;
+                    nviol = nviol_y;
+                    improved = true;
+                }
+            }
+        }
+        step = improved ? std::min(0.5, 2 * step) : step / 2;
+    }
+    return nviol == 0 ? 0 : h;
+}
+
+#endif
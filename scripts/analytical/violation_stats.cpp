@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rng_streams.hpp"
+#include "samplers.hpp"
+#include "../../problems/cpp/batch_constraints.hpp"
+#include "../../problems/cpp/problems.hpp"
+using namespace std;
+using namespace bbproblems;
+
+/*-----------------------------------------------------------------*/
+/*         Constraint-violation landscape of each (pb, family)     */
+/*-----------------------------------------------------------------*/
+//
+// Samples the bounds of each (problem, family) with a Sobol sequence and
+// computes, with eval_violations_batch, the distribution of
+// h = sum_j max(0, c_j)^2 and of the number of violated constraints. These
+// distributions help to choose h_init and rho_trigger (MadsParameters in
+// src/madsmodel.jl) per family without running the solvers.
+//
+// h is binned on a log10 scale (BINS_PER_DECADE bins per decade between
+// 10^H_MIN_EXP and 10^H_MAX_EXP, plus underflow and overflow bins); feasible
+// points (h = 0) are counted apart. Quantiles are interpolated in the bins.
+//
+// Compile: g++ -O3 -std=c++17 -pthread violation_stats.cpp -o violation_stats
+//
+// Usage: violation_stats [-p problem] [-f family] [-s samples] [-t threads] [-d dir]
+//                        [--isa name]
+//   -p    : one problem, by any name of find_problem, e.g. DTLZ2 or
+//           L2ZDT4-n1000-s1 (default: the problems of all_problems())
+//   --isa : instruction set of the kernels (scalar, sse42, avx2 or avx512;
+//           default: the widest of the CPU), printed in the first line
+//   Writes <dir>/<problem>_<family>_violation.txt (both histograms) and prints
+//   one summary line per pair:
+//   pair feasible_fraction h_q10 h_q25 h_q50 h_q75 h_q90 mean_nb_violated
+
+const int BATCH = 4096;
+const int H_MIN_EXP = -12;
+const int H_MAX_EXP = 12;
+const int BINS_PER_DECADE = 10;
+const int NB_H_BINS = (H_MAX_EXP - H_MIN_EXP) * BINS_PER_DECADE + 2; // + underflow, overflow
+
+struct ViolationStats
+{
+    const Problem *pb = nullptr;
+    int family = 0;
+    uint64_t samples = 0;
+    uint64_t feasible = 0;
+    vector<uint64_t> h_bins;    // infeasible points only
+    vector<uint64_t> nviol_bins; // index = number of violated constraints
+};
+
+static int h_bin(double h)
+{
+    double b = floor((log10(h) - H_MIN_EXP) * BINS_PER_DECADE);
+    if (b < 0)
+        return 0;
+    if (b >= NB_H_BINS - 2)
+        return NB_H_BINS - 1;
+    return static_cast<int>(b) + 1;
+}
+
+// lower bound of bin b (1 .. NB_H_BINS - 2)
+static double h_bin_low(int b)
+{
+    return pow(10.0, H_MIN_EXP + static_cast<double>(b - 1) / BINS_PER_DECADE);
+}
+
+static ViolationStats sample(const Problem &pb, int family, uint64_t samples, uint64_t seed)
+{
+    ViolationStats st;
+    st.pb = &pb;
+    st.family = family;
+    st.h_bins.assign(NB_H_BINS, 0);
+    st.nviol_bins.assign(nb_constraints(family, pb.n) + 1, 0);
+
+    // the same points on every platform and standard library
+    Sobol sampler(pb.n, (seed << 32) ^ stream_id(pb.name, static_cast<uint32_t>(family)));
+    PointBatch x(pb.n, BATCH);
+    vector<double> h;
+    vector<int> nviol;
+
+    for (uint64_t done = 0; done < samples; done += BATCH)
+    {
+        int nb = static_cast<int>(min<uint64_t>(BATCH, samples - done));
+        x.resize(nb);
+        sampler.next_batch(nb, pb.lb, pb.ub, x.data(), x.ld());
+        eval_violations_batch(family, x, h, nviol);
+
+        for (int k = 0; k < nb; ++k)
+        {
+            ++st.nviol_bins[nviol[k]];
+            if (nviol[k] == 0)
+                ++st.feasible;
+            else
+                ++st.h_bins[h_bin(h[k])];
+        }
+        st.samples += nb;
+    }
+    return st;
+}
+
+// q-quantile of h over the infeasible points, log-interpolated in its bin
+static double h_quantile(const ViolationStats &st, double q)
+{
+    uint64_t total = st.samples - st.feasible;
+    if (total == 0)
+        return NAN;
+    double target = q * total;
+    double cumul = 0;
+    for (int b = 0; b < NB_H_BINS; ++b)
+    {
+        if (cumul + st.h_bins[b] >= target && st.h_bins[b] > 0)
+        {
+            if (b == 0)
+                return pow(10.0, H_MIN_EXP);
+            if (b == NB_H_BINS - 1)
+                return pow(10.0, H_MAX_EXP);
+            double t = (target - cumul) / st.h_bins[b];
+            return h_bin_low(b) * pow(10.0, t / BINS_PER_DECADE);
+        }
+        cumul += st.h_bins[b];
+    }
+    return pow(10.0, H_MAX_EXP);
+}
+
+static void write_histograms(const string &dir, const ViolationStats &st)
+{
+    string path = dir + "/" + st.pb->name + "_" + to_string(st.family) + "_violation.txt";
+    ofstream out(path);
+    if (!out)
+        throw runtime_error("cannot write " + path);
+
+    out << "# " << st.pb->name << "_" << st.family << ": " << st.samples << " samples, "
+        << st.feasible << " feasible\n";
+    out << "# h histogram of the infeasible points: h_low h_high count\n";
+    out << 0 << " " << pow(10.0, H_MIN_EXP) << " " << st.h_bins[0] << "\n";
+    for (int b = 1; b < NB_H_BINS - 1; ++b)
+    {
+        out << h_bin_low(b) << " " << h_bin_low(b + 1) << " " << st.h_bins[b] << "\n";
+    }
+    out << pow(10.0, H_MAX_EXP) << " inf " << st.h_bins[NB_H_BINS - 1] << "\n";
+
+    out << "\n\n# number of violated constraints: nb count\n";
+    for (size_t k = 0; k < st.nviol_bins.size(); ++k)
+    {
+        out << k << " " << st.nviol_bins[k] << "\n";
+    }
+}
+
+static void usage()
+{
+    cerr << "Usage: violation_stats [-p problem] [-f family] [-s samples] [-t threads] [-d dir]\n"
+            "                       [--isa name]\n";
+    exit(EXIT_FAILURE);
+}
+
+/*------------------------------------------*/
+/*            main function                 */
+/*------------------------------------------*/
+int main(int argc, char **argv)
+{
+    string name;
+    int family = 0;
+    uint64_t samples = 1 << 20;
+    int nthreads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    string dir = ".";
+    string isa;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "-p" && i + 1 < argc)
+            name = argv[++i];
+        else if (arg == "-f" && i + 1 < argc)
+            family = atoi(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc)
+            samples = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "-t" && i + 1 < argc)
+            nthreads = max(1, atoi(argv[++i]));
+        else if (arg == "-d" && i + 1 < argc)
+            dir = argv[++i];
+        else if (arg == "--isa" && i + 1 < argc)
+            isa = argv[++i];
+        else
+            usage();
+    }
+    if (family < 0 || family > NB_FAMILIES)
+        usage();
+
+    try
+    {
+        // the problem of -p, any name known by find_problem (DTLZ, WFG and
+        // scalable variants too), or all the problems of the drivers
+        vector<const Problem *> problems;
+        if (name.empty())
+        {
+            for (const Problem &pb : all_problems())
+                problems.push_back(&pb);
+        }
+        else if (find_problem(name) != nullptr)
+            problems.push_back(find_problem(name));
+        else
+            throw runtime_error("unknown problem " + name);
+        if (!isa.empty())
+            simd::force_isa(simd::parse_isa(isa));
+
+        vector<ViolationStats> stats;
+        for (const Problem *pb : problems)
+        {
+            for (int fam = 1; fam <= NB_FAMILIES; ++fam)
+            {
+                if (family == 0 || fam == family)
+                {
+                    stats.push_back(ViolationStats());
+                    stats.back().pb = pb;
+                    stats.back().family = fam;
+                }
+            }
+        }
+
+        atomic<size_t> next(0);
+        vector<thread> pool;
+        for (int t = 0; t < nthreads; ++t)
+        {
+            pool.emplace_back([&]()
+                              {
+                for (size_t k = next++; k < stats.size(); k = next++)
+                    stats[k] = sample(*stats[k].pb, stats[k].family, samples, 1234); });
+        }
+        for (thread &th : pool)
+        {
+            th.join();
+        }
+
+        cout << "# isa: " << simd::isa_report() << "\n";
+        cout << "# pair feasible_fraction h_q10 h_q25 h_q50 h_q75 h_q90 mean_nb_violated\n";
+        cout.precision(6);
+        for (const ViolationStats &st : stats)
+        {
+            write_histograms(dir, st);
+
+            double mean_nviol = 0;
+            for (size_t k = 0; k < st.nviol_bins.size(); ++k)
+            {
+                mean_nviol += static_cast<double>(k) * st.nviol_bins[k];
+            }
+            mean_nviol /= st.samples;
+
+            cout << st.pb->name << "_" << st.family << " "
+                 << static_cast<double>(st.feasible) / st.samples;
+            for (double q : {0.1, 0.25, 0.5, 0.75, 0.9})
+            {
+                cout << " " << h_quantile(st, q);
+            }
+            cout << " " << mean_nviol << "\n";
+        }
+    }
+    catch (exception &e)
+    {
+        cerr << "\nviolation_stats has been interrupted (" << e.what() << ")\n\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}